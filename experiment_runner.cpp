@@ -0,0 +1,575 @@
+#include "experiment_runner.h"
+#include "rcpsp_hash.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <new>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_set>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/file.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace fs = std::filesystem;
+
+/* ===================================================================
+   Вспомогательные функции
+   =================================================================== */
+static std::string host_name()
+{
+    char buf[256] = {0};
+    if (gethostname(buf, sizeof(buf) - 1) != 0)
+        return "localhost";
+    return buf;
+}
+
+std::vector<std::string> list_instances(const fs::path& dir)
+{
+    std::vector<std::string> files;
+    for (const auto& entry : fs::recursive_directory_iterator(dir)) {
+        if (entry.is_regular_file() &&
+            entry.path().filename() != ".DS_Store") {
+            files.push_back(fs::relative(entry.path(), dir).generic_string());
+        }
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+static std::string cell_key(const std::string& instance, const std::string& config)
+{
+    return instance + '\t' + config;
+}
+
+// Ключи уже записанных результатов. Строка без '\n' в конце файла —
+// результат оборванной записи, она не считается
+static std::unordered_set<std::string> load_completed(const fs::path& results_dir)
+{
+    std::unordered_set<std::string> done;
+    for (const auto& entry : fs::directory_iterator(results_dir)) {
+        if (!entry.is_regular_file() || entry.path().extension() != ".tsv")
+            continue;
+
+        std::ifstream fin(entry.path(), std::ios::binary);
+        std::stringstream ss;
+        ss << fin.rdbuf();
+        std::string data = ss.str();
+
+        size_t pos = 0;
+        size_t nl;
+        while ((nl = data.find('\n', pos)) != std::string::npos) {
+            std::string line = data.substr(pos, nl - pos);
+            pos = nl + 1;
+
+            size_t tab1 = line.find('\t');
+            if (tab1 == std::string::npos) continue;
+            size_t tab2 = line.find('\t', tab1 + 1);
+            if (tab2 == std::string::npos) continue;
+            done.insert(line.substr(0, tab2));
+        }
+    }
+    return done;
+}
+
+static bool write_all(int fd, const std::string& data)
+{
+    const char* p = data.data();
+    size_t left = data.size();
+    while (left > 0) {
+        ssize_t n = write(fd, p, left);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        p += n;
+        left -= (size_t)n;
+    }
+    return true;
+}
+
+static void fsync_dir(const fs::path& dir)
+{
+    int fd = open(dir.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    fsync(fd);
+    close(fd);
+}
+
+// Файл результатов этого процесса: results/<host>-<pid>.tsv
+static fs::path results_path(const fs::path& work_dir)
+{
+    return work_dir / "results" /
+        (host_name() + "-" + std::to_string(getpid()) + ".tsv");
+}
+
+static std::string result_line(const std::string& instance, const std::string& config,
+                               const SolveResult& result)
+{
+    std::ostringstream line;
+    line << instance << '\t' << config << '\t' << result.status << '\t';
+    if (result.feasible) line << result.makespan;
+    else                 line << '-';
+    line << '\t' << result.seconds << '\t' << host_name() << '\n';
+    return line.str();
+}
+
+static std::string claim_owner()
+{
+    return host_name() + " " + std::to_string(getpid()) + "\n";
+}
+
+// Атомарный захват шарда: O_EXCL работает и на общей ФС (NFSv3+)
+static bool try_claim(const fs::path& claim)
+{
+    int fd = open(claim.c_str(), O_CREAT | O_EXCL | O_WRONLY, 0644);
+    if (fd < 0) return false;
+    write_all(fd, claim_owner());
+    fsync(fd);
+    close(fd);
+    return true;
+}
+
+/* Заявка брошена, если процесс-владелец на этой машине умер
+   или владелец давно не обновлял heartbeat (mtime файла) */
+static void release_stale_claims(const fs::path& claims_dir, double timeout)
+{
+    const std::string host = host_name();
+    const auto now = fs::file_time_type::clock::now();
+
+    for (const auto& entry : fs::directory_iterator(claims_dir)) {
+        if (entry.path().extension() != ".claim") continue;
+
+        std::ifstream fin(entry.path());
+        std::string owner_host;
+        pid_t owner_pid = 0;
+        fin >> owner_host >> owner_pid;
+
+        bool stale = false;
+        if (owner_host == host && owner_pid > 0 &&
+            kill(owner_pid, 0) != 0 && errno == ESRCH)
+            stale = true;
+
+        std::error_code ec;
+        auto mtime = fs::last_write_time(entry.path(), ec);
+        if (!ec && std::chrono::duration<double>(now - mtime).count() > timeout)
+            stale = true;
+
+        if (stale) {
+            std::cerr << "Снимаю брошенную заявку " << entry.path().filename()
+                      << " (" << owner_host << " " << owner_pid << ")\n";
+            fs::remove(entry.path(), ec);
+        }
+    }
+}
+
+/* Фоновое обновление mtime заявки, пока воркер жив: один запуск SCIP
+   может длиться дольше claim_timeout (или вообще без лимита времени) */
+class ClaimHeartbeat {
+public:
+    ClaimHeartbeat(fs::path claim, double claim_timeout)
+        : claim(std::move(claim)),
+          period(std::clamp(claim_timeout / 4.0, 1.0, 60.0)),
+          thread([this] { run(); })
+    {
+    }
+
+    ~ClaimHeartbeat() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        cv.notify_all();
+        thread.join();
+    }
+
+private:
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!cv.wait_for(lock, period, [this] { return stop; })) {
+            std::error_code ec;
+            fs::last_write_time(claim, fs::file_time_type::clock::now(), ec);
+        }
+    }
+
+    fs::path claim;
+    std::chrono::duration<double> period;
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool stop = false;
+    std::thread thread;   // последним: стартует, когда остальные поля готовы
+};
+
+/* Привязка воркера к одному ядру из разрешённых процессу (cpuset
+   контейнера или cgroup). Ядро занимается flock на cpus/<host>-cpu<N>.lock,
+   поэтому воркеры разных координаторов на одной машине не делят ядро;
+   блокировка снимается сама при выходе воркера */
+static void pin_to_core(const fs::path& lock_dir, int slot)
+{
+#ifdef __linux__
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        std::cerr << "sched_getaffinity: " << std::strerror(errno) << "\n";
+        return;
+    }
+    std::vector<int> cpus;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        if (CPU_ISSET(cpu, &allowed)) cpus.push_back(cpu);
+    if (cpus.empty()) return;
+
+    std::error_code ec;
+    fs::create_directories(lock_dir, ec);
+    const std::string host = host_name();
+
+    for (size_t k = 0; k < cpus.size(); ++k) {
+        int cpu = cpus[(slot + k) % cpus.size()];
+        fs::path lock = lock_dir / (host + "-cpu" + std::to_string(cpu) + ".lock");
+        int fd = open(lock.c_str(), O_CREAT | O_RDWR | O_CLOEXEC, 0644);
+        if (fd < 0) continue;
+        if (flock(fd, LOCK_EX | LOCK_NB) != 0) {
+            close(fd);
+            continue;
+        }
+        // fd не закрывается: блокировка держится до конца воркера
+
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        if (sched_setaffinity(0, sizeof(set), &set) != 0)
+            std::cerr << "sched_setaffinity(" << cpu << "): "
+                      << std::strerror(errno) << "\n";
+        return;
+    }
+    std::cerr << "Все разрешённые ядра заняты, воркер работает без привязки\n";
+#else
+    (void)lock_dir;
+    (void)slot;   // на macOS жёсткой привязки к ядру нет
+#endif
+}
+
+static double physical_memory_mb()
+{
+    long pages = sysconf(_SC_PHYS_PAGES);
+    long page_size = sysconf(_SC_PAGE_SIZE);
+    if (pages <= 0 || page_size <= 0) return 0.0;
+    return (double)pages * (double)page_size / (1024.0 * 1024.0);
+}
+
+// Метка раскладки матрицы по шардам: номер шарда имеет смысл только
+// при тех же SM-файлах, конфигурациях и shard_size
+static std::string layout_tag(const std::vector<std::string>& instances,
+                              const std::vector<SolverConfig>& configs,
+                              int shard_size)
+{
+    // '\xff' не встречается в UTF-8 именах и разделяет поля
+    uint64_t hash = FNV1A_64_OFFSET;
+    for (const auto& instance : instances) hash = fnv1a_64(instance + '\xff', hash);
+    for (const auto& config : configs)     hash = fnv1a_64(config.name + '\xff', hash);
+    hash = fnv1a_64(std::to_string(shard_size) + '\xff', hash);
+    return hash_hex(hash);
+}
+
+static void limit_memory(double memory_limit_mb)
+{
+    if (memory_limit_mb <= 0) return;
+    struct rlimit rl;
+    rl.rlim_cur = rl.rlim_max = (rlim_t)(memory_limit_mb * 1024.0 * 1024.0);
+    setrlimit(RLIMIT_AS, &rl);
+}
+
+/* ===================================================================
+   Воркер: решает все ячейки одного шарда
+   =================================================================== */
+static int run_worker(const SweepOptions& options,
+                      const std::vector<std::string>& instances,
+                      size_t begin, size_t end,
+                      const fs::path& claim,
+                      const std::unordered_set<std::string>& completed,
+                      int slot)
+{
+    pin_to_core(options.work_dir / "cpus", slot);
+    limit_memory(options.memory_limit_mb);
+
+    // теперь заявкой владеет воркер, а не координатор
+    {
+        std::ofstream fout(claim, std::ios::trunc);
+        fout << claim_owner();
+    }
+
+    const fs::path results_file = results_path(options.work_dir);
+
+    int fd = open(results_file.c_str(), O_CREAT | O_APPEND | O_WRONLY, 0644);
+    if (fd < 0) {
+        std::cerr << "Не удалось открыть " << results_file << ": "
+                  << std::strerror(errno) << "\n";
+        return 1;
+    }
+    fsync_dir(results_file.parent_path());
+
+    ClaimHeartbeat heartbeat(claim, options.claim_timeout);
+
+    const size_t n_configs = options.configs.size();
+    size_t loaded = (size_t)-1;
+    RCPSPInstance inst;
+    bool parsed = false;
+
+    for (size_t cell = begin; cell < end; ++cell) {
+        size_t i = cell / n_configs;
+        SolverConfig config = options.configs[cell % n_configs];
+        const std::string& instance = instances[i];
+
+        if (completed.count(cell_key(instance, config.name)))
+            continue;
+
+        if (loaded != i) {
+            loaded = i;
+            try {
+                inst = parse_sm_file((options.instances_dir / instance).string());
+                parsed = true;
+            } catch (...) {
+                parsed = false;
+            }
+        }
+
+        SolveResult result;
+        if (!parsed) {
+            result.status = "parse_error";
+        } else {
+            config.quiet = true;
+            // мягкий лимит SCIP ниже жёсткого, чтобы успеть вернуть memlimit
+            if (options.memory_limit_mb > 0 &&
+                (config.memory_limit <= 0 || config.memory_limit > 0.9 * options.memory_limit_mb))
+                config.memory_limit = 0.9 * options.memory_limit_mb;
+
+            try {
+                if (solve_rcpsp(inst, options.model_options, config, result) != SCIP_OKAY)
+                    result.status = "error";
+            } catch (const std::bad_alloc&) {
+                // упёрлись в RLIMIT_AS раньше мягкого лимита SCIP
+                result = SolveResult();
+                result.status = "memlimit";
+            }
+        }
+
+        if (!write_all(fd, result_line(instance, config.name, result)) || fsync(fd) != 0) {
+            std::cerr << "Ошибка записи в " << results_file << ": "
+                      << std::strerror(errno) << "\n";
+            close(fd);
+            return 1;
+        }
+    }
+    close(fd);
+
+    // готовность шарда определяется по результатам, отдельного маркера нет
+    std::error_code ec;
+    fs::remove(claim, ec);
+    return 0;
+}
+
+/* ===================================================================
+   Координатор
+   =================================================================== */
+
+/* Воркер упал посреди шарда (abort в SoPlex под RLIMIT_AS, SIGSEGV,
+   OOM killer). Ячейки решаются по порядку, а каждый результат
+   записывается до начала следующей, поэтому упала первая нерешённая
+   ячейка шарда. Для неё дописывается строка crashed — иначе каждый
+   повторный запуск падал бы на ней же и не доходил до остальных */
+static void record_crash(const SweepOptions& options,
+                         const std::vector<std::string>& instances,
+                         size_t begin, size_t end)
+{
+    const std::unordered_set<std::string> done =
+        load_completed(options.work_dir / "results");
+    const size_t n_configs = options.configs.size();
+
+    for (size_t cell = begin; cell < end; ++cell) {
+        const std::string& instance = instances[cell / n_configs];
+        const std::string& config = options.configs[cell % n_configs].name;
+        if (done.count(cell_key(instance, config))) continue;
+
+        SolveResult result;
+        result.status = "crashed";
+
+        const fs::path results_file = results_path(options.work_dir);
+        int fd = open(results_file.c_str(), O_CREAT | O_APPEND | O_WRONLY, 0644);
+        if (fd < 0 || !write_all(fd, result_line(instance, config, result)) || fsync(fd) != 0)
+            std::cerr << "Ошибка записи в " << results_file << ": "
+                      << std::strerror(errno) << "\n";
+        else
+            std::cerr << "  ячейка " << instance << " / " << config << " записана как crashed\n";
+        if (fd >= 0) close(fd);
+        return;
+    }
+}
+
+std::vector<SolverConfig> default_sweep_configs(double time_limit)
+{
+    std::vector<SolverConfig> configs(4);
+
+    configs[0].name = "default";
+
+    configs[1].name = "presolve_fast";
+    configs[1].presolving = SCIP_PARAMSETTING_FAST;
+
+    configs[2].name = "heur_aggressive";
+    configs[2].heuristics = SCIP_PARAMSETTING_AGGRESSIVE;
+
+    configs[3].name = "emph_optimality";
+    configs[3].emphasis = SCIP_PARAMEMPHASIS_OPTIMALITY;
+
+    for (auto& config : configs)
+        config.time_limit = time_limit;
+    return configs;
+}
+
+int run_sweep(const SweepOptions& sweep)
+{
+    SweepOptions options = sweep;
+    if (options.configs.empty() || options.shard_size <= 0) {
+        std::cerr << "Пустой набор конфигураций или неверный размер шарда\n";
+        return 1;
+    }
+
+    const fs::path claims_dir  = options.work_dir / "claims";
+    const fs::path results_dir = options.work_dir / "results";
+
+    std::vector<std::string> instances;
+    try {
+        fs::create_directories(claims_dir);
+        fs::create_directories(results_dir);
+        instances = list_instances(options.instances_dir);
+    } catch (const std::exception& e) {
+        std::cerr << "Ошибка доступа к директории: " << e.what() << "\n";
+        return 1;
+    }
+
+    release_stale_claims(claims_dir, options.claim_timeout);
+    const std::unordered_set<std::string> completed = load_completed(results_dir);
+
+    const size_t n_configs = options.configs.size();
+    const size_t n_cells   = instances.size() * n_configs;
+    const size_t n_shards  = (n_cells + options.shard_size - 1) / options.shard_size;
+
+    int workers = options.workers;
+    if (workers <= 0)
+        workers = std::max(1u, std::thread::hardware_concurrency());
+
+    // по умолчанию воркеры делят 90% физической памяти поровну
+    if (options.memory_limit_mb == 0.0)
+        options.memory_limit_mb = 0.9 * physical_memory_mb() / workers;
+    else if (options.memory_limit_mb < 0.0)
+        options.memory_limit_mb = 0.0;
+
+    const std::string tag = layout_tag(instances, options.configs, options.shard_size);
+    auto claim_path = [&](size_t shard) {
+        return claims_dir / ("shard_" + tag + "_" + std::to_string(shard) + ".claim");
+    };
+
+    std::cout << instances.size() << " SM-файлов x " << n_configs
+              << " конфигураций = " << n_cells << " запусков, "
+              << n_shards << " шардов, уже решено " << completed.size()
+              << ", лимит памяти воркера " << (long)options.memory_limit_mb << " МБ\n";
+    std::cout.flush();
+
+    struct Running { size_t shard; int slot; };
+    std::map<pid_t, Running> running;
+    std::vector<bool> slot_busy(workers, false);
+    size_t next_shard = 0;
+    int failed = 0;
+
+    while (true) {
+        /* --- Запуск новых воркеров --- */
+        while ((int)running.size() < workers && next_shard < n_shards) {
+            size_t shard = next_shard++;
+            fs::path claim = claim_path(shard);
+
+            size_t begin = shard * options.shard_size;
+            size_t end   = std::min(n_cells, begin + options.shard_size);
+
+            bool all_done = true;
+            for (size_t cell = begin; cell < end && all_done; ++cell)
+                all_done = completed.count(cell_key(instances[cell / n_configs],
+                                                    options.configs[cell % n_configs].name)) > 0;
+            if (all_done) continue;
+
+            if (!try_claim(claim)) continue;   // шард у другого координатора
+
+            int slot = (int)(std::find(slot_busy.begin(), slot_busy.end(), false) - slot_busy.begin());
+
+            std::cout.flush();
+            pid_t pid = fork();
+            if (pid < 0) {
+                std::cerr << "fork: " << std::strerror(errno) << "\n";
+                fs::remove(claim);
+                --next_shard;
+                break;
+            }
+            if (pid == 0) {
+                int rc = run_worker(options, instances, begin, end,
+                                    claim, completed, slot);
+                _exit(rc);
+            }
+            slot_busy[slot] = true;
+            running[pid] = {shard, slot};
+        }
+
+        if (running.empty())
+            break;
+
+        /* --- Ожидание завершения любого воркера --- */
+        int status = 0;
+        pid_t pid = waitpid(-1, &status, 0);
+        if (pid < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        auto it = running.find(pid);
+        if (it == running.end()) continue;
+
+        size_t shard = it->second.shard;
+        slot_busy[it->second.slot] = false;
+        running.erase(it);
+
+        if (WIFEXITED(status) && WEXITSTATUS(status) == 0) {
+            std::cout << "Шард " << shard << " готов\n";
+        } else {
+            ++failed;
+            if (WIFSIGNALED(status)) {
+                int sig = WTERMSIG(status);
+                std::cerr << "Шард " << shard << ": воркер убит сигналом " << sig << "\n";
+                // остановку извне (Ctrl-C, kill) падением ячейки не считаем
+                if (sig != SIGINT && sig != SIGTERM && sig != SIGHUP) {
+                    size_t begin = shard * options.shard_size;
+                    record_crash(options, instances, begin,
+                                 std::min(n_cells, begin + options.shard_size));
+                }
+            } else {
+                std::cerr << "Шард " << shard << ": воркер завершился с кодом "
+                          << WEXITSTATUS(status) << "\n";
+            }
+            // заявку снимаем: следующий запуск продолжит шард с места падения
+            std::error_code ec;
+            fs::remove(claim_path(shard), ec);
+        }
+    }
+
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include "rcpsp_model.h"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+/* ===================================================================
+   Шардированный прогон экспериментов: (SM-файлы × конфигурации SCIP)
+
+   Матрица делится на шарды по shard_size ячеек. Координатор захватывает
+   шарды через файлы-заявки в общем каталоге work_dir и запускает по
+   одному процессу-воркеру на шард. Каждый результат сразу дописывается
+   (с fsync) в results/<host>-<pid>.tsv, поэтому после падения или kill
+   повторный запуск с тем же work_dir пропускает уже решённые ячейки.
+   Какие шарды готовы, решается только по этим результатам, так что
+   набор SM-файлов, конфигураций и shard_size между запусками можно
+   менять. Имена заявок содержат хэш раскладки матрицы.
+   Если воркер убит сигналом (abort, SIGSEGV, OOM killer), координатор
+   записывает первую нерешённую ячейку шарда как crashed, и повторный
+   запуск продолжает со следующей, а не падает на ней снова.
+   Несколько машин могут работать с одним work_dir на общей ФС.
+   =================================================================== */
+struct SweepOptions {
+    std::filesystem::path instances_dir;   // каталог с .sm (рекурсивно)
+    std::filesystem::path work_dir;        // общий каталог заявок и результатов
+    std::vector<SolverConfig> configs;
+    ModelOptions model_options;
+    int workers = 0;                  // 0 — по числу ядер
+    int shard_size = 64;              // ячеек матрицы на шард
+    double memory_limit_mb = 0.0;     // жёсткий лимит памяти воркера, МБ; 0 — 90% RAM / воркеры, < 0 — без ограничения
+    double claim_timeout = 3600.0;    // секунды без heartbeat, после которых чужая заявка считается брошенной
+};
+
+// Все SM-файлы каталога (рекурсивно), пути относительно dir, в стабильном порядке
+std::vector<std::string> list_instances(const std::filesystem::path& dir);
+
+// Набор конфигураций по умолчанию для --sweep
+std::vector<SolverConfig> default_sweep_configs(double time_limit);
+
+// Возвращает 0, если все доступные этому координатору шарды обработаны
+int run_sweep(const SweepOptions& options);
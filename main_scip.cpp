@@ -1,13 +1,19 @@
 #include "scip/scip.h"              // Основной интерфейс SCIP
-#include "scip/scipdefplugins.h"    // Стандартные плагины SCIP (LP, branching, heuristics)
 #include "rcpsp_parser.h"
+#include "rcpsp_model.h"            // MIP-модель RCPSP и запуск SCIP
+#include "rcpsp_cache.h"
+#include "experiment_runner.h"
+#include "rcpsp_tuning.h"
+#include "schedule_editor.h"        // инкрементальный пересчёт при редактировании
 
 #include <iostream>
 #include <filesystem>
 #include <vector>
 #include <string>
 #include <algorithm>
-#include <chrono>
+#include <cstdlib>
+#include <cmath>
+#include <memory>
 #include <map>
 #include <utility>
 
@@ -27,28 +33,53 @@
 #include <QFrame>
 #include <QGraphicsPathItem>
 #include <QPainterPath>
+#include <QGraphicsLineItem>
+#include <QGraphicsTextItem>
+#include <QPushButton>
+#include <QLabel>
+#include <QThread>
+#include <QPaintEvent>
 
 namespace fs = std::filesystem;
 
+// Результат --tune; если файл есть, решатель читает его при запуске
+static const char* TUNED_SETTINGS = "../rcpsp_tuned.set";
+
 /* ===================================================================
    Виджет таймлайна (ось времени, фиксированная внизу)
    =================================================================== */
 class TimelineWidget : public QWidget {
 public:
     TimelineWidget(double maxTime, double scale, int margin, int totalWidth,
+                   const ScheduleEditor* editor = nullptr,
                    QWidget* parent = nullptr)
         : QWidget(parent),
           maxTime(maxTime),
           scale(scale),
           margin(margin),
-          totalWidth(totalWidth)
+          totalWidth(totalWidth),
+          editor(editor)
     {
         setFixedHeight(50);
         setMinimumWidth(totalWidth);
     }
 
+    void setMaxTime(double t) {
+        maxTime = t;
+        totalWidth = margin * 2 + (int)(scale * t);
+        setMinimumWidth(totalWidth);
+        update();
+    }
+
+    // Перерисовка только моментов [from, to] (с запасом на подписи)
+    void updateRange(int from, int to) {
+        int x0 = margin + (int)((from - 2) * scale);
+        int x1 = margin + (int)((to + 3) * scale);
+        update(QRect(x0, 0, x1 - x0, height()));
+    }
+
 protected:
-    void paintEvent(QPaintEvent*) override {
+    void paintEvent(QPaintEvent* event) override {
         QPainter painter(this);
         painter.setRenderHint(QPainter::Antialiasing);
 
@@ -56,7 +87,21 @@ protected:
         int timeStep   = 1;
         int timelineY  = 10;
 
-        for (int t = 0; t <= (int)maxTime; t += timeStep) {
+        /* --- Видимый диапазон времени (только область event->rect()) --- */
+        const QRect area = event->rect();
+        int tFrom = std::max(0, (int)std::floor((area.left() - margin) / scale) - 2);
+        int tTo   = std::min((int)maxTime, (int)std::ceil((area.right() - margin) / scale) + 2);
+
+        /* --- Моменты перегрузки ресурсов --- */
+        if (editor) {
+            for (int t = tFrom; t <= tTo; ++t) {
+                if (!editor->overloaded_at(t)) continue;
+                painter.fillRect(margin + (int)(t * scale), 0, (int)scale, timelineY,
+                                 QColor(224, 82, 77, 160));
+            }
+        }
+
+        for (int t = tFrom - tFrom % timeStep; t <= tTo; t += timeStep) {
             int x = margin + (int)(t * scale);
 
             painter.drawLine(x, timelineY, x, timelineY + tickHeight);
@@ -74,14 +119,222 @@ private:
     double scale;
     int margin;
     int totalWidth;
+    const ScheduleEditor* editor;
 };
 
+/* ===================================================================
+   Редактирование диаграммы Ганта
+   =================================================================== */
+class TaskItem;
+
+// Связывает ScheduleEditor со сценой: после каждого сдвига
+// перерисовываются только задачи, которые вернул редактор
+struct GanttEditor {
+    ScheduleEditor editor;
+    SolverConfig config;                 // для локальной переоптимизации
+    std::map<int, TaskItem*> items;      // только нефиктивные задачи
+    QGraphicsScene* scene = nullptr;
+    TimelineWidget* timeline = nullptr;
+    QLabel* status = nullptr;
+    QPushButton* reoptButton = nullptr;
+    double scale;
+    int margin;
+    int sceneHeight;
+    double maxTime;
+    bool syncing = false;                // позиции меняет программа, а не мышь
+    bool busy = false;                   // идёт фоновая переоптимизация
+
+    GanttEditor(const RCPSPInstance& inst, const ModelOptions& options,
+                const std::vector<std::pair<int, double>>& starts)
+        : editor(inst, options, starts) {}
+
+    int  onDrag(int task_id, int new_start);
+    void refresh(const std::vector<int>& ids, int dragged = 0);
+    void reoptimize();
+    void finishReoptimize(bool ok, const SolveResult& result, size_t regionSize);
+    int  countConflicts() const;
+};
+
+class TaskItem : public QGraphicsPathItem {
+public:
+    TaskItem(int task_id, int w, int h, GanttEditor* owner)
+        : task_id(task_id), owner(owner)
+    {
+        int radius = h / 4;
+        QPainterPath path;
+        path.addRoundedRect(0, 0, w, h, radius, radius);
+        setPath(path);
+        setPen(QPen(Qt::black));
+
+        setFlag(QGraphicsItem::ItemIsMovable);
+        setFlag(QGraphicsItem::ItemSendsGeometryChanges);
+        setCursor(Qt::OpenHandCursor);
+    }
+
+protected:
+    QVariant itemChange(GraphicsItemChange change, const QVariant& value) override {
+        if (change == ItemPositionChange && !owner->syncing) {
+            // только по горизонтали и с шагом в единицу времени
+            QPointF p = value.toPointF();
+            int start = (int)std::lround((p.x() - owner->margin) / owner->scale);
+            int placed = owner->onDrag(task_id, start);
+            return QPointF(owner->margin + placed * owner->scale, y());
+        }
+        return QGraphicsPathItem::itemChange(change, value);
+    }
+
+private:
+    int task_id;
+    GanttEditor* owner;
+};
+
+int GanttEditor::onDrag(int task_id, int new_start)
+{
+    // пока SCIP считает по снимку расписания, правки запрещены
+    if (busy)
+        return editor.start(task_id);
+
+    std::vector<int> changed = editor.move_task(task_id, new_start);
+    if (!changed.empty())
+        refresh(changed, task_id);
+    return editor.start(task_id);
+}
+
+void GanttEditor::refresh(const std::vector<int>& ids, int dragged)
+{
+    syncing = true;
+    double newMax = maxTime;
+
+    for (int id : ids) {
+        auto it = items.find(id);
+        if (it == items.end()) continue;
+        TaskItem* item = it->second;
+
+        int start = editor.start(id);
+        int duration = editor.duration(id);
+        newMax = std::max(newMax, (double)(start + duration));
+
+        // позицию перетаскиваемой задачи Qt выставит сам из itemChange
+        if (id != dragged)
+            item->setPos(margin + start * scale, item->y());
+
+        QColor color("#61C554");
+        if (editor.has_conflict(id))  color = QColor("#E0524D");   // перегрузка ресурса
+        else if (editor.is_late(id))  color = QColor("#F0A030");   // позже исходного makespan
+        item->setBrush(QBrush(color));
+
+        item->setToolTip(QString("Task %1\nstart = %2\nduration = %3\nES = %4, LS = %5%6%7")
+                         .arg(id)
+                         .arg(start)
+                         .arg(duration)
+                         .arg(editor.earliest_start(id))
+                         .arg(editor.latest_start(id))
+                         .arg(editor.is_pinned(id) ? QString("\nзакреплена") : QString())
+                         .arg(editor.has_conflict(id) ? QString("\nперегрузка ресурса") : QString()));
+    }
+
+    int from, to;
+    if (newMax > maxTime) {
+        maxTime = newMax;
+        scene->setSceneRect(0, 0, margin * 2 + (int)(scale * maxTime), sceneHeight);
+        timeline->setMaxTime(maxTime);
+    } else if (editor.last_dirty_range(from, to)) {
+        timeline->updateRange(from, to);
+    }
+    syncing = false;
+}
+
+int GanttEditor::countConflicts() const
+{
+    int count = 0;
+    for (const auto& [id, item] : items)
+        if (editor.has_conflict(id)) ++count;
+    return count;
+}
+
+// Модели SCIP (build_rcpsp_model и модель области) запрещают только попарные конфликты
+// usage_i + usage_j > capacity, поэтому перегрузку тремя и более задачами
+// и после переоптимизации редактор может показать красным
+static const char* PAIRWISE_NOTE =
+    "модель SCIP запрещает только попарные конфликты ресурсов";
+
+void GanttEditor::reoptimize()
+{
+    if (busy) return;
+
+    std::vector<int> region = editor.changed_region();
+    if (region.empty()) {
+        status->setText("Нет сдвинутых задач");
+        return;
+    }
+
+    SolverConfig local = config;
+    local.quiet = true;
+    if (local.time_limit <= 0) local.time_limit = 10.0;
+
+    busy = true;
+    reoptButton->setEnabled(false);
+    status->setText(QString("Переоптимизация %1 задач...").arg(region.size()));
+
+    // решение в отдельном потоке по копии данных, GUI не блокируется
+    auto result = std::make_shared<SolveResult>();
+    auto ok     = std::make_shared<bool>(false);
+    QThread* worker = QThread::create(
+        [result, ok, local, region,
+         inst = editor.instance(),
+         options = editor.model_options(),
+         starts = editor.schedule()]() {
+            *ok = solve_rcpsp_region(inst, options, local, starts, region, *result) == SCIP_OKAY;
+        });
+
+    size_t regionSize = region.size();
+    QObject::connect(worker, &QThread::finished, status,
+                     [this, worker, result, ok, regionSize]() {
+                         finishReoptimize(*ok, *result, regionSize);
+                         worker->deleteLater();
+                     });
+    worker->start();
+}
+
+void GanttEditor::finishReoptimize(bool ok, const SolveResult& result, size_t regionSize)
+{
+    busy = false;
+    reoptButton->setEnabled(true);
+
+    if (!ok) {
+        status->setText("Ошибка SCIP при переоптимизации");
+        return;
+    }
+    if (!result.feasible) {
+        status->setText(QString("Для области нет допустимого расписания (%1)")
+                        .arg(QString::fromStdString(result.status)));
+        return;
+    }
+
+    refresh(editor.assign(result.starts));
+    refresh(editor.clear_changed());   // закрепления сняты — ES/LS пересчитаны
+
+    QString text = QString("Область из %1 задач: makespan = %2 (%3)")
+                   .arg(regionSize)
+                   .arg(result.makespan)
+                   .arg(QString::fromStdString(result.status));
+    int conflicts = countConflicts();
+    if (conflicts > 0)
+        text += QString("; осталось %1 задач с перегрузкой — %2")
+                .arg(conflicts).arg(PAIRWISE_NOTE);
+    status->setText(text);
+}
+
 /* ===================================================================
    Отрисовка диаграммы Ганта
    =================================================================== */
 void showGanttChart(const std::vector<std::pair<int, double>>& starts,
-                    const std::vector<Task>& tasks)
+                    const RCPSPInstance& inst,
+                    const ModelOptions& options,
+                    const SolverConfig& config)
 {
+    const std::vector<Task>& tasks = inst.tasks;
+
     int taskHeight = 25;
     int spacing    = 5;
     int margin     = 20;
@@ -103,23 +356,36 @@ void showGanttChart(const std::vector<std::pair<int, double>>& starts,
 
     QGraphicsScene* scene = new QGraphicsScene(0, 0, width, height);
 
+    GanttEditor* gantt = new GanttEditor(inst, options, starts);
+    gantt->config      = config;
+    gantt->scene       = scene;
+    gantt->scale       = scale;
+    gantt->margin      = margin;
+    gantt->sceneHeight = height;
+    gantt->maxTime     = maxTime;
+
     /* --- Отрисовка задач --- */
+    gantt->syncing = true;   // начальные setPos — не перетаскивание
     for (size_t i = 0; i < starts.size(); ++i) {
         int task_id      = starts[i].first;
         double startTime = starts[i].second;
         const Task* task = task_map[task_id];
         if (!task) continue;
 
+        /* --- Прямоугольник и подпись (не для фиктивных задач) --- */
+        if (task->duration <= 0) continue;
+
         int x = margin + (int)(startTime * scale);
         int y = margin + i * (taskHeight + spacing);
         int w = (int)(task->duration * scale);
 
-        /* --- Пунктирные проекции --- */
-        // (не для фиктивных задач):
-        if (task->duration > 0 &&
-            task_id != 1 &&
-            task_id != (int)tasks.size())
-        {
+        TaskItem* rect = new TaskItem(task_id, w, taskHeight, gantt);
+        rect->setPos(x, y);
+        scene->addItem(rect);
+        gantt->items[task_id] = rect;
+
+        /* --- Пунктирные проекции (двигаются вместе с задачей) --- */
+        if (task_id != 1 && task_id != (int)tasks.size()) {
             int timelineHeight = 50;
             int timelineY = height - timelineHeight;
 
@@ -127,39 +393,22 @@ void showGanttChart(const std::vector<std::pair<int, double>>& starts,
             dashedPen.setWidthF(1.0);
             dashedPen.setDashPattern({5, 5});
 
-            scene->addLine(x,     y + taskHeight, x,     timelineY, dashedPen);
-            scene->addLine(x + w, y + taskHeight, x + w, timelineY, dashedPen);
-        }
-
-
-        /* --- Прямоугольник и подпись (не для фиктивных задач) --- */
-        if (task->duration > 0) {
-
-            int radius = taskHeight / 4;
-            QPainterPath path;
-            path.addRoundedRect(x, y, w, taskHeight, radius, radius);
-
-            QGraphicsPathItem* rect = scene->addPath(
-                path,
-                QPen(Qt::black),
-                QBrush(QColor("#61C554"))
-            );
-
-            rect->setToolTip(QString("Task %1\nstart = %2\nduration = %3")
-                             .arg(task_id)
-                             .arg(startTime)
-                             .arg(task->duration));
-
-            /* --- Подпись задачи --- */
-            QGraphicsTextItem* text = scene->addText(QString::number(task_id));
-            text->setDefaultTextColor(Qt::black);  // ← ты уже хотел чёрный
-            text->setPos(
-                x + w / 2 - text->boundingRect().width() / 2,
-                y + taskHeight / 2 - text->boundingRect().height() / 2
-            );
+            auto* left  = new QGraphicsLineItem(0, taskHeight, 0, timelineY - y, rect);
+            auto* right = new QGraphicsLineItem(w, taskHeight, w, timelineY - y, rect);
+            left->setPen(dashedPen);
+            right->setPen(dashedPen);
         }
 
+        /* --- Подпись задачи --- */
+        QGraphicsTextItem* text = new QGraphicsTextItem(QString::number(task_id), rect);
+        text->setDefaultTextColor(Qt::black);
+        text->setAcceptedMouseButtons(Qt::NoButton);
+        text->setPos(
+            w / 2 - text->boundingRect().width() / 2,
+            taskHeight / 2 - text->boundingRect().height() / 2
+        );
     }
+    gantt->syncing = false;
 
     /* --- Компоновка окна --- */
     QWidget* mainWidget = new QWidget();
@@ -169,6 +418,15 @@ void showGanttChart(const std::vector<std::pair<int, double>>& starts,
     layout->setContentsMargins(0, 0, 0, 0);
     layout->setSpacing(0);
 
+    QHBoxLayout* toolbar = new QHBoxLayout();
+    toolbar->setContentsMargins(8, 4, 8, 4);
+    QPushButton* reoptButton = new QPushButton("Переоптимизировать изменённое");
+    QLabel* status = new QLabel("Перетаскивайте задачи мышью");
+    toolbar->addWidget(reoptButton);
+    toolbar->addWidget(status, 1);
+    gantt->status = status;
+    gantt->reoptButton = reoptButton;
+
     QGraphicsView* view = new QGraphicsView(scene);
     view->setHorizontalScrollBarPolicy(Qt::ScrollBarAsNeeded);
     view->setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
@@ -180,14 +438,29 @@ void showGanttChart(const std::vector<std::pair<int, double>>& starts,
     timelineArea->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
 
     TimelineWidget* timeline =
-        new TimelineWidget(maxTime, scale, margin, width);
+        new TimelineWidget(maxTime, scale, margin, width, &gantt->editor);
     timelineArea->setWidget(timeline);
+    gantt->timeline = timeline;
 
     QObject::connect(view->horizontalScrollBar(), &QScrollBar::valueChanged,
                      [timelineArea](int v) {
                          timelineArea->horizontalScrollBar()->setValue(v);
                      });
+    QObject::connect(reoptButton, &QPushButton::clicked,
+                     [gantt]() { gantt->reoptimize(); });
 
+    /* --- Начальные цвета и подсказки --- */
+    std::vector<int> all_ids;
+    for (const auto& [id, item] : gantt->items)
+        all_ids.push_back(id);
+    gantt->refresh(all_ids);
+
+    int conflicts = gantt->countConflicts();
+    if (conflicts > 0)
+        status->setText(QString("%1 задач с перегрузкой ресурсов — %2")
+                        .arg(conflicts).arg(PAIRWISE_NOTE));
+
+    layout->addLayout(toolbar, 0);
     layout->addWidget(view, 1);
     layout->addWidget(timelineArea, 0);
 
@@ -197,8 +470,41 @@ void showGanttChart(const std::vector<std::pair<int, double>>& starts,
 
 
 
-int main()
+int main(int argc, char** argv)
 {
+    /* ---------- Режим прогона экспериментов ---------- */
+    // RCPSP --sweep <каталог SM> <общий рабочий каталог> [воркеры] [размер шарда] [лимит, с] [память воркера, МБ]
+    if (argc >= 4 && std::string(argv[1]) == "--sweep") {
+        SweepOptions sweep;
+        sweep.instances_dir = argv[2];
+        sweep.work_dir      = argv[3];
+        if (argc >= 5) sweep.workers    = std::atoi(argv[4]);
+        if (argc >= 6) sweep.shard_size = std::atoi(argv[5]);
+        double time_limit = (argc >= 7) ? std::atof(argv[6]) : 60.0;
+        if (argc >= 8) sweep.memory_limit_mb = std::atof(argv[7]);
+        sweep.configs       = default_sweep_configs(time_limit);
+        sweep.model_options = default_model_options();
+        if (fs::exists(TUNED_SETTINGS)) {
+            SolverConfig tuned = tuned_config(TUNED_SETTINGS);
+            tuned.time_limit = time_limit;
+            sweep.configs.push_back(tuned);
+        }
+        return run_sweep(sweep);
+    }
+
+    /* ---------- Подбор параметров SCIP ---------- */
+    // RCPSP --tune <каталог обучающих SM> [.set] [экземпляров] [кандидатов] [лимит, с]
+    if (argc >= 3 && std::string(argv[1]) == "--tune") {
+        TuningOptions tuning;
+        tuning.train_dir = argv[2];
+        tuning.output    = (argc >= 4) ? argv[3] : TUNED_SETTINGS;
+        if (argc >= 5) tuning.max_instances = std::atoi(argv[4]);
+        if (argc >= 6) tuning.n_candidates  = std::atoi(argv[5]);
+        if (argc >= 7) tuning.time_limit    = std::atof(argv[6]);
+        tuning.model_options = default_model_options();
+        return run_tuning(tuning);
+    }
+
     /* ---------- Выбор входного SM-файла ---------- */
     const std::string dir_path = "../sm_files/j30.sm";
     std::string sm_file;
@@ -231,389 +537,26 @@ int main()
         return 1;
     }
 
-    /* ---------- Инициализация SCIP ---------- */
-    SCIP* scip = nullptr;
-    SCIP_CALL(SCIPcreate(&scip));
-    SCIP_CALL(SCIPincludeDefaultPlugins(scip));
-    SCIP_CALL(SCIPcreateProbBasic(scip, "rcpsp_30"));
-
-    /* ---------- Переменные начала задач ---------- */
-    std::vector<SCIP_VAR*> start_vars(inst.n_jobs, nullptr);
-
-    for (const auto& t : inst.tasks) {
-        SCIP_VAR* var = nullptr;
-        std::string name = "t" + std::to_string(t.id);
-        SCIP_CALL(SCIPcreateVarBasic(
-            scip, &var, name.c_str(),
-            0.0, SCIPinfinity(scip), 1e-4, SCIP_VARTYPE_INTEGER));
-        SCIP_CALL(SCIPaddVar(scip, var));
-        start_vars[t.id - 1] = var;
-    }
-
-    /* ---------- Переменная makespan ---------- */
-    SCIP_VAR* makespan = nullptr;
-    SCIP_CALL(SCIPcreateVarBasic(
-        scip, &makespan, "makespan",
-        0.0, SCIPinfinity(scip), 1.0, SCIP_VARTYPE_CONTINUOUS));
-    SCIP_CALL(SCIPaddVar(scip, makespan));
-
-    /* ---------- Ограничения предшествования ---------- */
-    for (const auto& t : inst.tasks) {
-        for (int succ : t.successors) {
-            SCIP_CONS* cons = nullptr;
-            SCIP_VAR* vars[]  = { start_vars[succ - 1], start_vars[t.id - 1] };
-            SCIP_Real coefs[] = { 1.0, -1.0 };
-
-            SCIP_CALL(SCIPcreateConsBasicLinear(
-                scip, &cons, "prec",
-                2, vars, coefs,
-                t.duration, SCIPinfinity(scip)));
-
-            SCIP_CALL(SCIPaddCons(scip, cons));
-            SCIP_CALL(SCIPreleaseCons(scip, &cons));
-        }
-    }
-
-    /* ---------- Ограничения makespan ---------- */
-    // ( привязываем makespan к концу последней задачи: для каждой задачи t должен быть больше чем конец данной t )
-    for (const auto& t : inst.tasks) {
-        SCIP_CONS* cons = nullptr;
-        SCIP_VAR* vars[]  = { makespan, start_vars[t.id - 1] };
-        SCIP_Real coefs[] = { 1.0, -1.0 };
-
-        SCIP_CALL(SCIPcreateConsBasicLinear(
-            scip, &cons, "makespan",
-            2, vars, coefs,
-            t.duration, SCIPinfinity(scip)));
-
-        SCIP_CALL(SCIPaddCons(scip, cons));
-        SCIP_CALL(SCIPreleaseCons(scip, &cons));
-    }
-
-
-
-    /* =======================================================================
-        Ограничения ресурсов (разные виды 1. 2. 3.)
-        ======================================================================= */
-
-    /* -----------------------------------------------------------------------
-        1. Ограничения ёмкости ресурсов (resource capacity constraints)
-        Сравниваем каждую задачу с каждой. Если конфликтуют по ресурсу, то вводится дизъюнкция:
-        либо первая задача выполняется раньше второй, либо наоборот
-        ( через бинарную переменную и big-M ограничения )
-        ----------------------------------------------------------------------- */
-    for (int r = 0; r < inst.n_resources; ++r) {                // по ресурсам
-        int capacity = inst.resources[r].capacity;
-
-        for (size_t i = 0; i < inst.tasks.size(); ++i) {        // по таскам №1
-            const auto& task_i = inst.tasks[i];
-            int usage_i = (r < (int)task_i.resources.size()) ? task_i.resources[r] : 0;
-            if (usage_i == 0) continue;
-
-            for (size_t j = i + 1; j < inst.tasks.size(); ++j) {        // по таскам №2
-                const auto& task_j = inst.tasks[j];
-                int usage_j = (r < (int)task_j.resources.size()) ? task_j.resources[r] : 0;
-                if (usage_j == 0) continue;
-
-                /* Если суммарное потребление превышает ёмкость ресурса,
-                   задачи не могут выполняться одновременно */
-                if (usage_i + usage_j > capacity) {
-
-                    // Бинарная переменная y_i_j_r порядка выполнения задач  --  тоже оптимизируемая переменная в SCIP
-                    std::string y_name = "y_" + std::to_string(task_i.id) + "_" +
-                                         std::to_string(task_j.id) + "_r" +
-                                         std::to_string(r);
-                    SCIP_VAR* y_var = nullptr;
-                    SCIP_CALL(SCIPcreateVarBasic(
-                        scip, &y_var, y_name.c_str(),
-                        0.0, 1.0, 0.0, SCIP_VARTYPE_BINARY));
-                    SCIP_CALL(SCIPaddVar(scip, y_var));
-
-                    // Большая константа для big-M ограничений
-                    SCIP_Real M = 0.0;
-                    for (const auto& t : inst.tasks)
-                        M += t.duration;
-                    M += 1000;
-
-                    /* y = 1 ⇒ task_i завершается до начала task_j */
-                    SCIP_CONS* cons1 = nullptr;
-                    SCIP_VAR* vars1[] = {
-                        start_vars[task_j.id - 1],
-                        start_vars[task_i.id - 1],
-                        y_var
-                    };
-                    SCIP_Real coefs1[] = {1.0, -1.0, -M};
-
-
-                    SCIP_CALL(SCIPcreateConsBasicLinear(
-                        scip, &cons1,
-                        ("resource_order_" + std::to_string(task_i.id) + "_" +
-                         std::to_string(task_j.id) + "_r" +
-                         std::to_string(r) + "_1").c_str(),
-                        3, vars1, coefs1,
-                        task_i.duration - M, SCIPinfinity(scip)));
-                    SCIP_CALL(SCIPaddCons(scip, cons1));
-                    SCIP_CALL(SCIPreleaseCons(scip, &cons1));
-
-                    /* y = 0 ⇒ task_j завершается до начала task_i */
-                    SCIP_CONS* cons2 = nullptr;
-                    SCIP_VAR* vars2[] = {
-                        start_vars[task_i.id - 1],
-                        start_vars[task_j.id - 1],
-                        y_var
-                    };
-                    SCIP_Real coefs2[] = {1.0, -1.0, M};
-
-                    SCIP_CALL(SCIPcreateConsBasicLinear(
-                        scip, &cons2,
-                        ("resource_order_" + std::to_string(task_i.id) + "_" +
-                         std::to_string(task_j.id) + "_r" +
-                         std::to_string(r) + "_2").c_str(),
-                        3, vars2, coefs2,
-                        task_j.duration, SCIPinfinity(scip)));
-                    SCIP_CALL(SCIPaddCons(scip, cons2));
-                    SCIP_CALL(SCIPreleaseCons(scip, &cons2));
-
-                    SCIP_CALL(SCIPreleaseVar(scip, &y_var));
-                }
-            }
-        }
-    }
-
-
-
-    /* -----------------------------------------------------------------------
-        2. Ограничения недоступных интервалов ресурсов
-        Каждая задача либо полностью завершается до начала интервала,
-        либо начинается после его окончания
-        ----------------------------------------------------------------------- */
-
-    // resource_unavailability[r] — список временных интервалов [L, U), в которые ресурс r полностью недоступен
-    std::map<int, std::vector<std::pair<int,int>>> resource_unavailability;
-
-    resource_unavailability[0] = {{30, 40}};
-    resource_unavailability[1] = {{30, 40}};
-    resource_unavailability[2] = {{30, 40}};
-    resource_unavailability[3] = {{30, 40}};
-
-    for (const auto& task : inst.tasks) {
-        for (int r = 0; r < inst.n_resources; ++r) {
-            int usage = (r < (int)task.resources.size()) ? task.resources[r] : 0;
-            if (usage == 0) continue;
-
-            if (resource_unavailability.find(r) != resource_unavailability.end()) { // если для ресурса r заданы ограничения в resource_unavailability
-                for (const auto& [L, U] : resource_unavailability[r]) {
-
-                    // Бинарная переменная выбора стороны интервала
-                    std::string z_name = "z_" + std::to_string(task.id) +
-                                         "_r" + std::to_string(r) +
-                                         "_" + std::to_string(L) +
-                                         "_" + std::to_string(U);
-                    SCIP_VAR* z_var = nullptr;
-                    SCIP_CALL(SCIPcreateVarBasic(
-                        scip, &z_var, z_name.c_str(),
-                        0.0, 1.0, 0.0, SCIP_VARTYPE_BINARY));
-                    SCIP_CALL(SCIPaddVar(scip, z_var));
-
-                    SCIP_Real M = 0.0;
-                    for (const auto& t : inst.tasks)
-                        M += t.duration;
-                    M += 1000;
-
-                    /* z = 1 ⇒ задача завершается до L */
-                    SCIP_CONS* cons_before = nullptr;
-                    SCIP_VAR* vars_before[] = {
-                        start_vars[task.id - 1],
-                        z_var
-                    };
-                    SCIP_Real coefs_before[] = {1.0, M};
-
-                    SCIP_CALL(SCIPcreateConsBasicLinear(
-                        scip, &cons_before,
-                        ("unavail_before_" + std::to_string(task.id) +
-                         "_r" + std::to_string(r) + "_" +
-                         std::to_string(L)).c_str(),
-                        2, vars_before, coefs_before,
-                        -SCIPinfinity(scip),
-                        L - task.duration + M));
-                    SCIP_CALL(SCIPaddCons(scip, cons_before));
-                    SCIP_CALL(SCIPreleaseCons(scip, &cons_before));
-
-                    /* z = 0 ⇒ задача начинается после U */
-                    SCIP_CONS* cons_after = nullptr;
-                    SCIP_VAR* vars_after[] = {
-                        start_vars[task.id - 1],
-                        z_var
-                    };
-                    SCIP_Real coefs_after[] = {1.0, M};
-
-                    SCIP_CALL(SCIPcreateConsBasicLinear(
-                        scip, &cons_after,
-                        ("unavail_after_" + std::to_string(task.id) +
-                         "_r" + std::to_string(r) + "_" +
-                         std::to_string(U)).c_str(),
-                        2, vars_after, coefs_after,
-                        U, SCIPinfinity(scip)));
-                    SCIP_CALL(SCIPaddCons(scip, cons_after));
-                    SCIP_CALL(SCIPreleaseCons(scip, &cons_after));
-
-                    SCIP_CALL(SCIPreleaseVar(scip, &z_var));
-                }
-            }
-        }
-    }
-
-
-
-    /* ------------------------------------------------------------
-        3. Time-dependent capacity ресурсов
-        capacity[r][t] — ёмкость ресурса r в момент времени t
-        ------------------------------------------------------------ */
-    // число переменных  =  кол-во тасков  x  кол-во моментов времени
-
-    std::map<int, std::map<int, int>> time_capacity;
-
-    // пример: по 3 момента для каждого из 4 ресурсов
-    // ресурс 0
-    time_capacity[0][10] = 2;
-    time_capacity[0][11] = 1;
-    time_capacity[0][12] = 3;
-
-    // ресурс 1
-    time_capacity[1][10] = 1;
-    time_capacity[1][11] = 1;
-    time_capacity[1][12] = 2;
-
-    // ресурс 2
-    time_capacity[2][10] = 2;
-    time_capacity[2][11] = 2;
-    time_capacity[2][12] = 2;
-
-    // ресурс 3
-    time_capacity[3][10] = 1;
-    time_capacity[3][11] = 2;
-    time_capacity[3][12] = 1;
-
-    // Переменные x_{i,t} = 1  <=>  задача i активна в момент t
-
-    std::map<std::pair<int,int>, SCIP_VAR*> x_vars;
-
-    // Большое M
-    SCIP_Real M = 0.0;
-    for (const auto& t : inst.tasks)
-        M += t.duration;
-    M += 1000;
-
-    // определение индикаторов x_task_t
-    for (const auto& task : inst.tasks) {
-        if (task.duration == 0) continue;
-
-        for (const auto& [r, cap_map] : time_capacity) {        // по всем ресурсам r
-            for (const auto& [t, cap] : cap_map) {      // по всем временам t
-
-                std::string name = "x_" + std::to_string(task.id) +
-                                   "_t" + std::to_string(t);
-
-                SCIP_VAR* x = nullptr;            // x = 1   =>   задача task выполняется в t   ;   x = 0   =>   не выполняется   (оптимизируется SCIP-ом)
-                SCIP_CALL(SCIPcreateVarBasic(
-                    scip, &x, name.c_str(),
-                    0.0, 1.0, 0.0, SCIP_VARTYPE_BINARY));
-                SCIP_CALL(SCIPaddVar(scip, x));
-
-                x_vars[{task.id, t}] = x;
-
-                /* start_i <= t + M*(1-x) */        // задача началась до текущего t
-                SCIP_CONS* c1 = nullptr;
-                SCIP_VAR* v1[] = { start_vars[task.id - 1], x };
-                SCIP_Real a1[] = { 1.0,  M };
-
-                SCIP_CALL(SCIPcreateConsBasicLinear(
-                    scip, &c1, "active_lb",
-                    2, v1, a1,
-                    -SCIPinfinity(scip),
-                    t + M));
-                SCIP_CALL(SCIPaddCons(scip, c1));
-                SCIP_CALL(SCIPreleaseCons(scip, &c1));
-
-                /* start_i + dur_i >= t+1 - M*(1-x) */    // задача закончится после текущего t
-                SCIP_CONS* c2 = nullptr;
-                SCIP_VAR* v2[] = { start_vars[task.id - 1], x };
-                SCIP_Real a2[] = { 1.0, -M };
-
-                SCIP_CALL(SCIPcreateConsBasicLinear(
-                    scip, &c2, "active_ub",
-                    2, v2, a2,
-                    t + 1 - task.duration - M,
-                    SCIPinfinity(scip)));
-                SCIP_CALL(SCIPaddCons(scip, c2));
-                SCIP_CALL(SCIPreleaseCons(scip, &c2));
-            }
-        }
-    }
-
-    // передача ограничений на ресурсы во времени в SCIP
-
-    for (const auto& [r, cap_map] : time_capacity) {
-        for (const auto& [t, cap] : cap_map) {
-
-            SCIP_CONS* cons = nullptr;
-            std::vector<SCIP_VAR*> vars;
-            std::vector<SCIP_Real> coefs;
-
-            for (const auto& task : inst.tasks) {
-                int usage = (r < (int)task.resources.size())  // теоретически задача может использовать ресурс r
-                            ? task.resources[r]
-                            : 0;
-                if (usage == 0 || task.duration == 0) continue;
-
-                auto it = x_vars.find({task.id, t});     // переменная x_i_t
-                if (it == x_vars.end()) continue;
-
-                vars.push_back(it->second);
-                coefs.push_back((SCIP_Real)usage);
-                // sum ( usage_i_r x x_i_t )   -- то есть сколько данного ресурса r используется в t
-            }
-
-            if (!vars.empty()) {
-                SCIP_CALL(SCIPcreateConsBasicLinear(
-                    scip, &cons,
-                    ("cap_r" + std::to_string(r) +
-                     "_t" + std::to_string(t)).c_str(),
-                    vars.size(),
-                    vars.data(),
-                    coefs.data(),
-                    -SCIPinfinity(scip),
-                    cap));
-                    // то есть  -inf  <  sum ( usage_i_r x x_i_t )  <  капасити r
-                SCIP_CALL(SCIPaddCons(scip, cons));
-                SCIP_CALL(SCIPreleaseCons(scip, &cons));
-            }
-        }
-    }
-
-
-
     /* ---------- Решение ---------- */
-    auto t_start = std::chrono::high_resolution_clock::now();
-    SCIP_CALL(SCIPsolve(scip));
-    auto t_end = std::chrono::high_resolution_clock::now();
+    // повторный запуск на том же экземпляре берёт модель/оптимум из кэша
+    ModelCache cache("../model_cache");
+    SolverConfig config;
+    if (fs::exists(TUNED_SETTINGS))
+        config.settings_file = TUNED_SETTINGS;
+
+    SolveResult result;
+    SCIP_CALL(solve_rcpsp_cached(inst, default_model_options(), config, cache, result));
 
-    SCIP_SOL* sol = SCIPgetBestSol(scip);
-    if (!sol) {
+    if (!result.feasible) {
         std::cout << "No feasible solution\n";
         return 0;
     }
 
-    std::vector<std::pair<int, double>> starts;
-    for (int id = 1; id <= inst.n_jobs; ++id)
-        starts.emplace_back(id,
-            SCIPgetSolVal(scip, sol, start_vars[id - 1]));
-
     /* ---------- Визуализация ---------- */
-    int argc = 0;
-    char* argv[] = {nullptr};
-    QApplication app(argc, argv);
-    showGanttChart(starts, inst.tasks);
+    int qt_argc = 0;
+    char* qt_argv[] = {nullptr};
+    QApplication app(qt_argc, qt_argv);
+    showGanttChart(result.starts, inst, default_model_options(), config);
 
     return app.exec();
 }
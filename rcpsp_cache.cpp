@@ -0,0 +1,306 @@
+#include "rcpsp_cache.h"
+#include "rcpsp_hash.h"
+#include "scip/scipdefplugins.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+// Меняется при любом изменении build_rcpsp_model, чтобы старые .cip не подхватывались
+static const char* MODEL_FORMAT = "rcpsp-mip-v1";
+
+/* ===================================================================
+   Ключ кэша
+   =================================================================== */
+std::string model_cache_key(const RCPSPInstance& inst, const ModelOptions& options)
+{
+    // каноническая запись: задачи по id, ресурсы и календари по порядку
+    std::ostringstream canon;
+    canon << MODEL_FORMAT << ';' << inst.n_jobs << ';' << inst.n_resources << ';';
+
+    for (const auto& res : inst.resources)
+        canon << res.capacity << ',';
+    canon << ';';
+
+    std::vector<const Task*> tasks;
+    for (const auto& task : inst.tasks)
+        tasks.push_back(&task);
+    std::sort(tasks.begin(), tasks.end(),
+              [](const Task* a, const Task* b) { return a->id < b->id; });
+
+    for (const Task* task : tasks) {
+        canon << task->id << ':' << task->duration << '[';
+        for (int r : task->resources) canon << r << ',';
+        canon << "][";
+        for (int s : task->successors) canon << s << ',';
+        canon << "];";
+    }
+
+    canon << "U";
+    for (const auto& [r, intervals] : options.resource_unavailability) {
+        canon << r << '{';
+        for (const auto& [L, U] : intervals) canon << L << '-' << U << ',';
+        canon << '}';
+    }
+    canon << "C";
+    for (const auto& [r, cap_map] : options.time_capacity) {
+        canon << r << '{';
+        for (const auto& [t, cap] : cap_map) canon << t << '=' << cap << ',';
+        canon << '}';
+    }
+
+    return hash_hex(fnv1a_64(canon.str()));
+}
+
+/* ===================================================================
+   ModelCache
+   =================================================================== */
+ModelCache::ModelCache(fs::path dir)
+    : cache_dir(std::move(dir))
+{
+    std::error_code ec;
+    fs::create_directories(cache_dir, ec);
+}
+
+fs::path ModelCache::model_path(const std::string& key) const
+{
+    return cache_dir / (key + ".cip");
+}
+
+fs::path ModelCache::schedule_path(const std::string& key) const
+{
+    return cache_dir / (key + ".sched");
+}
+
+// Временный файл рядом с целевым: rename() на той же ФС атомарен,
+// поэтому параллельные процессы никогда не видят недописанный файл
+static fs::path temp_path(const fs::path& target)
+{
+    return target.string() + ".tmp." + std::to_string(getpid());
+}
+
+/* Блокировка flock на <key>.sched.lock: чтение, сравнение и замена
+   .sched должны быть одной операцией, иначе параллельный процесс может
+   заменить лучшее расписание худшим. Файл блокировки не удаляется,
+   а flock снимается ядром при завершении процесса, поэтому «брошенных»
+   блокировок нет и чистить по mtime нечего */
+class ScheduleLock {
+public:
+    explicit ScheduleLock(const fs::path& path) {
+        fd = open(path.c_str(), O_CREAT | O_RDWR | O_CLOEXEC, 0644);
+        if (fd < 0) return;
+
+        using namespace std::chrono;
+        auto deadline = steady_clock::now() + seconds(5);
+        while (flock(fd, LOCK_EX | LOCK_NB) != 0) {
+            if ((errno != EWOULDBLOCK && errno != EINTR) ||
+                steady_clock::now() > deadline) {
+                close(fd);
+                fd = -1;
+                return;
+            }
+            std::this_thread::sleep_for(milliseconds(10));
+        }
+    }
+
+    ~ScheduleLock() {
+        if (fd >= 0) close(fd);   // закрытие снимает flock
+    }
+
+    ScheduleLock(const ScheduleLock&) = delete;
+    ScheduleLock& operator=(const ScheduleLock&) = delete;
+
+    bool held() const { return fd >= 0; }
+
+private:
+    int fd = -1;
+};
+
+bool ModelCache::load_schedule(const std::string& key, int n_jobs, SolveResult& result) const
+{
+    std::ifstream fin(schedule_path(key));
+    if (!fin.is_open())
+        return false;
+
+    SolveResult cached;
+    std::string word;
+    int n = 0;
+    if (!(fin >> word >> cached.status) || word != "status") return false;
+    if (!(fin >> word >> cached.makespan) || word != "makespan") return false;
+    if (!(fin >> word >> n) || word != "starts" || n != n_jobs) return false;
+
+    // id потом индексируют переменные модели — проверяем каждый
+    std::vector<char> seen(n_jobs + 1, 0);
+    for (int k = 0; k < n; ++k) {
+        int id;
+        double start;
+        if (!(fin >> id >> start)) return false;
+        if (id < 1 || id > n_jobs || seen[id]) return false;
+        seen[id] = 1;
+        cached.starts.emplace_back(id, start);
+    }
+
+    cached.feasible = true;
+    result = cached;
+    return true;
+}
+
+void ModelCache::store_schedule(const std::string& key, const SolveResult& result) const
+{
+    if (!result.feasible)
+        return;
+
+    const fs::path target = schedule_path(key);
+    ScheduleLock lock(target.string() + ".lock");
+    if (!lock.held())
+        return;   // кэш — не источник истины, запись можно пропустить
+
+    SolveResult old;
+    if (load_schedule(key, (int)result.starts.size(), old)) {
+        if (old.status == "optimal")
+            return;
+        if (result.status != "optimal" && result.makespan >= old.makespan)
+            return;
+    }
+
+    const fs::path tmp = temp_path(target);
+    {
+        std::ofstream fout(tmp, std::ios::trunc);
+        fout.precision(17);
+        fout << "status "   << result.status   << "\n"
+             << "makespan " << result.makespan << "\n"
+             << "starts "   << result.starts.size() << "\n";
+        for (const auto& [id, start] : result.starts)
+            fout << id << " " << start << "\n";
+        if (!fout) {
+            fout.close();
+            std::error_code ec;
+            fs::remove(tmp, ec);
+            return;
+        }
+    }
+    std::error_code ec;
+    fs::rename(tmp, target, ec);
+}
+
+/* ===================================================================
+   Решение через кэш
+   =================================================================== */
+
+// Переменные t<id> и makespan загруженной из .cip модели
+static bool find_model_vars(SCIP* scip, const RCPSPInstance& inst,
+                            std::vector<SCIP_VAR*>& start_vars,
+                            SCIP_VAR*& makespan)
+{
+    start_vars.assign(inst.n_jobs, nullptr);
+    makespan = SCIPfindVar(scip, "makespan");
+    if (!makespan) return false;
+
+    for (int id = 1; id <= inst.n_jobs; ++id) {
+        start_vars[id - 1] = SCIPfindVar(scip, ("t" + std::to_string(id)).c_str());
+        if (!start_vars[id - 1]) return false;
+    }
+    return true;
+}
+
+SCIP_RETCODE solve_rcpsp_cached(const RCPSPInstance& inst,
+                                const ModelOptions& options,
+                                const SolverConfig& config,
+                                const ModelCache& cache,
+                                SolveResult& result)
+{
+    auto t_start = std::chrono::high_resolution_clock::now();
+    const std::string key = model_cache_key(inst, options);
+
+    /* ---------- Оптимум уже известен ---------- */
+    SolveResult best_known;
+    bool have_best = cache.load_schedule(key, inst.n_jobs, best_known);
+    if (have_best && best_known.status == "optimal") {
+        result = best_known;
+        result.from_cache = true;
+        result.seconds = std::chrono::duration<double>(
+            std::chrono::high_resolution_clock::now() - t_start).count();
+        return SCIP_OKAY;
+    }
+
+    SCIP* scip = nullptr;
+    SCIP_CALL(SCIPcreate(&scip));
+    SCIP_CALL(SCIPincludeDefaultPlugins(scip));
+    SCIP_CALL(apply_solver_config(scip, config));
+
+    /* ---------- Модель: из .cip или построение ---------- */
+    std::vector<SCIP_VAR*> start_vars;
+    SCIP_VAR* makespan = nullptr;
+    const fs::path model = cache.model_path(key);
+
+    bool loaded = false;
+    if (fs::exists(model)) {
+        if (SCIPreadProb(scip, model.c_str(), "cip") == SCIP_OKAY &&
+            find_model_vars(scip, inst, start_vars, makespan)) {
+            for (auto* var : start_vars)
+                SCIP_CALL(SCIPcaptureVar(scip, var));
+            SCIP_CALL(SCIPcaptureVar(scip, makespan));
+            loaded = true;
+        } else {
+            SCIP_CALL(SCIPfreeProb(scip));   // битый файл — строим заново
+        }
+    }
+
+    if (!loaded) {
+        SCIP_CALL(build_rcpsp_model(scip, inst, options, start_vars, makespan));
+
+        const fs::path tmp = temp_path(model);
+        std::error_code ec;
+        if (SCIPwriteOrigProblem(scip, tmp.c_str(), "cip", FALSE) == SCIP_OKAY)
+            fs::rename(tmp, model, ec);
+        else
+            fs::remove(tmp, ec);
+    }
+
+    /* ---------- Старт с лучшего известного расписания ---------- */
+    // задаются только начала задач, бинарные переменные SCIP достроит сам
+    if (have_best) {
+        SCIP_SOL* partial = nullptr;
+        SCIP_Bool stored = FALSE;
+        SCIP_CALL(SCIPcreatePartialSol(scip, &partial, nullptr));
+        for (const auto& [id, start] : best_known.starts)
+            SCIP_CALL(SCIPsetSolVal(scip, partial, start_vars[id - 1], start));
+        SCIP_CALL(SCIPsetSolVal(scip, partial, makespan, best_known.makespan));
+        SCIP_CALL(SCIPaddSolFree(scip, &partial, &stored));
+    }
+
+    /* ---------- Решение ---------- */
+    SCIP_CALL(SCIPsolve(scip));
+    auto t_end = std::chrono::high_resolution_clock::now();
+
+    result = SolveResult();
+    result.status  = status_name(SCIPgetStatus(scip));
+    result.seconds = std::chrono::duration<double>(t_end - t_start).count();
+
+    SCIP_SOL* sol = SCIPgetBestSol(scip);
+    if (sol) {
+        result.feasible = true;
+        result.makespan = SCIPgetSolVal(scip, sol, makespan);
+        for (int id = 1; id <= inst.n_jobs; ++id)
+            result.starts.emplace_back(id,
+                SCIPgetSolVal(scip, sol, start_vars[id - 1]));
+    }
+
+    for (auto& var : start_vars)
+        SCIP_CALL(SCIPreleaseVar(scip, &var));
+    SCIP_CALL(SCIPreleaseVar(scip, &makespan));
+    SCIP_CALL(SCIPfree(&scip));
+
+    cache.store_schedule(key, result);
+    return SCIP_OKAY;
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include "rcpsp_model.h"
+
+#include <filesystem>
+#include <string>
+
+/* ===================================================================
+   Кэш построенных моделей и решений на диске
+
+   Ключ — хэш содержимого RCPSPInstance вместе с ModelOptions.
+   <key>.cip   — исходная модель SCIP (читается вместо build_rcpsp_model)
+   <key>.sched — лучшее найденное расписание; если оно оптимально,
+                 SCIP не запускается вовсе
+   =================================================================== */
+
+// Хэш экземпляра и опций модели (16 hex-символов)
+std::string model_cache_key(const RCPSPInstance& inst, const ModelOptions& options);
+
+class ModelCache {
+public:
+    explicit ModelCache(std::filesystem::path dir);
+
+    std::filesystem::path model_path(const std::string& key) const;
+    std::filesystem::path schedule_path(const std::string& key) const;
+
+    // Расписание экземпляра из n_jobs задач; файл с другим числом задач,
+    // id вне [1, n_jobs] или повторами id считается битым
+    bool load_schedule(const std::string& key, int n_jobs, SolveResult& result) const;
+    // Записывает расписание, только если оно лучше уже сохранённого
+    void store_schedule(const std::string& key, const SolveResult& result) const;
+
+private:
+    std::filesystem::path cache_dir;
+};
+
+// solve_rcpsp с кэшем: оптимум из кэша, иначе модель из .cip
+// (или построение с сохранением) и старт с лучшего известного расписания
+SCIP_RETCODE solve_rcpsp_cached(const RCPSPInstance& inst,
+                                const ModelOptions& options,
+                                const SolverConfig& config,
+                                const ModelCache& cache,
+                                SolveResult& result);
@@ -0,0 +1,29 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+/* ===================================================================
+   FNV-1a 64 — хэш ключей кэша, меток раскладки и .set-файлов.
+   Потоковый: fnv1a_64(b, fnv1a_64(a)) == fnv1a_64(a + b)
+   =================================================================== */
+constexpr uint64_t FNV1A_64_OFFSET = 1469598103934665603ULL;
+
+inline uint64_t fnv1a_64(const std::string& data, uint64_t hash = FNV1A_64_OFFSET)
+{
+    for (unsigned char c : data) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Младшие digits * 4 бит хэша в hex (digits <= 16)
+inline std::string hash_hex(uint64_t hash, int digits = 16)
+{
+    if (digits < 16)
+        hash &= (1ULL << (4 * digits)) - 1;
+    char buf[17];
+    std::snprintf(buf, sizeof(buf), "%0*llx", digits, (unsigned long long)hash);
+    return buf;
+}
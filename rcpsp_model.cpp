@@ -0,0 +1,782 @@
+#include "rcpsp_model.h"
+#include "scip/scipdefplugins.h"
+
+#include <algorithm>
+#include <chrono>
+
+ModelOptions default_model_options()
+{
+    ModelOptions options;
+
+    options.resource_unavailability[0] = {{30, 40}};
+    options.resource_unavailability[1] = {{30, 40}};
+    options.resource_unavailability[2] = {{30, 40}};
+    options.resource_unavailability[3] = {{30, 40}};
+
+    // пример: по 3 момента для каждого из 4 ресурсов
+    // ресурс 0
+    options.time_capacity[0][10] = 2;
+    options.time_capacity[0][11] = 1;
+    options.time_capacity[0][12] = 3;
+
+    // ресурс 1
+    options.time_capacity[1][10] = 1;
+    options.time_capacity[1][11] = 1;
+    options.time_capacity[1][12] = 2;
+
+    // ресурс 2
+    options.time_capacity[2][10] = 2;
+    options.time_capacity[2][11] = 2;
+    options.time_capacity[2][12] = 2;
+
+    // ресурс 3
+    options.time_capacity[3][10] = 1;
+    options.time_capacity[3][11] = 2;
+    options.time_capacity[3][12] = 1;
+
+    return options;
+}
+
+std::string status_name(SCIP_STATUS status)
+{
+    switch (status) {
+        case SCIP_STATUS_OPTIMAL:    return "optimal";
+        case SCIP_STATUS_INFEASIBLE: return "infeasible";
+        case SCIP_STATUS_UNBOUNDED:  return "unbounded";
+        case SCIP_STATUS_TIMELIMIT:  return "timelimit";
+        case SCIP_STATUS_MEMLIMIT:   return "memlimit";
+        case SCIP_STATUS_USERINTERRUPT: return "interrupted";
+        default:                     return "unknown";
+    }
+}
+
+/* ===================================================================
+   Построение MIP-модели RCPSP
+   =================================================================== */
+SCIP_RETCODE build_rcpsp_model(SCIP* scip,
+                               const RCPSPInstance& inst,
+                               const ModelOptions& options,
+                               std::vector<SCIP_VAR*>& start_vars,
+                               SCIP_VAR*& makespan)
+{
+    SCIP_CALL(SCIPcreateProbBasic(scip, "rcpsp"));
+
+    /* ---------- Переменные начала задач ---------- */
+    start_vars.assign(inst.n_jobs, nullptr);
+
+    for (const auto& t : inst.tasks) {
+        SCIP_VAR* var = nullptr;
+        std::string name = "t" + std::to_string(t.id);
+        SCIP_CALL(SCIPcreateVarBasic(
+            scip, &var, name.c_str(),
+            0.0, SCIPinfinity(scip), 1e-4, SCIP_VARTYPE_INTEGER));
+        SCIP_CALL(SCIPaddVar(scip, var));
+        start_vars[t.id - 1] = var;
+    }
+
+    /* ---------- Переменная makespan ---------- */
+    SCIP_CALL(SCIPcreateVarBasic(
+        scip, &makespan, "makespan",
+        0.0, SCIPinfinity(scip), 1.0, SCIP_VARTYPE_CONTINUOUS));
+    SCIP_CALL(SCIPaddVar(scip, makespan));
+
+    /* ---------- Ограничения предшествования ---------- */
+    for (const auto& t : inst.tasks) {
+        for (int succ : t.successors) {
+            SCIP_CONS* cons = nullptr;
+            SCIP_VAR* vars[]  = { start_vars[succ - 1], start_vars[t.id - 1] };
+            SCIP_Real coefs[] = { 1.0, -1.0 };
+
+            SCIP_CALL(SCIPcreateConsBasicLinear(
+                scip, &cons, "prec",
+                2, vars, coefs,
+                t.duration, SCIPinfinity(scip)));
+
+            SCIP_CALL(SCIPaddCons(scip, cons));
+            SCIP_CALL(SCIPreleaseCons(scip, &cons));
+        }
+    }
+
+    /* ---------- Ограничения makespan ---------- */
+    // ( привязываем makespan к концу последней задачи: для каждой задачи t должен быть больше чем конец данной t )
+    for (const auto& t : inst.tasks) {
+        SCIP_CONS* cons = nullptr;
+        SCIP_VAR* vars[]  = { makespan, start_vars[t.id - 1] };
+        SCIP_Real coefs[] = { 1.0, -1.0 };
+
+        SCIP_CALL(SCIPcreateConsBasicLinear(
+            scip, &cons, "makespan",
+            2, vars, coefs,
+            t.duration, SCIPinfinity(scip)));
+
+        SCIP_CALL(SCIPaddCons(scip, cons));
+        SCIP_CALL(SCIPreleaseCons(scip, &cons));
+    }
+
+
+
+    /* =======================================================================
+        Ограничения ресурсов (разные виды 1. 2. 3.)
+        ======================================================================= */
+
+    /* -----------------------------------------------------------------------
+        1. Ограничения ёмкости ресурсов (resource capacity constraints)
+        Сравниваем каждую задачу с каждой. Если конфликтуют по ресурсу, то вводится дизъюнкция:
+        либо первая задача выполняется раньше второй, либо наоборот
+        ( через бинарную переменную и big-M ограничения )
+        ----------------------------------------------------------------------- */
+    for (int r = 0; r < inst.n_resources; ++r) {                // по ресурсам
+        int capacity = inst.resources[r].capacity;
+
+        for (size_t i = 0; i < inst.tasks.size(); ++i) {        // по таскам №1
+            const auto& task_i = inst.tasks[i];
+            int usage_i = (r < (int)task_i.resources.size()) ? task_i.resources[r] : 0;
+            if (usage_i == 0) continue;
+
+            for (size_t j = i + 1; j < inst.tasks.size(); ++j) {        // по таскам №2
+                const auto& task_j = inst.tasks[j];
+                int usage_j = (r < (int)task_j.resources.size()) ? task_j.resources[r] : 0;
+                if (usage_j == 0) continue;
+
+                /* Если суммарное потребление превышает ёмкость ресурса,
+                   задачи не могут выполняться одновременно */
+                if (usage_i + usage_j > capacity) {
+
+                    // Бинарная переменная y_i_j_r порядка выполнения задач  --  тоже оптимизируемая переменная в SCIP
+                    std::string y_name = "y_" + std::to_string(task_i.id) + "_" +
+                                         std::to_string(task_j.id) + "_r" +
+                                         std::to_string(r);
+                    SCIP_VAR* y_var = nullptr;
+                    SCIP_CALL(SCIPcreateVarBasic(
+                        scip, &y_var, y_name.c_str(),
+                        0.0, 1.0, 0.0, SCIP_VARTYPE_BINARY));
+                    SCIP_CALL(SCIPaddVar(scip, y_var));
+
+                    // Большая константа для big-M ограничений
+                    SCIP_Real M = 0.0;
+                    for (const auto& t : inst.tasks)
+                        M += t.duration;
+                    M += 1000;
+
+                    /* y = 1 ⇒ task_i завершается до начала task_j */
+                    SCIP_CONS* cons1 = nullptr;
+                    SCIP_VAR* vars1[] = {
+                        start_vars[task_j.id - 1],
+                        start_vars[task_i.id - 1],
+                        y_var
+                    };
+                    SCIP_Real coefs1[] = {1.0, -1.0, -M};
+
+
+                    SCIP_CALL(SCIPcreateConsBasicLinear(
+                        scip, &cons1,
+                        ("resource_order_" + std::to_string(task_i.id) + "_" +
+                         std::to_string(task_j.id) + "_r" +
+                         std::to_string(r) + "_1").c_str(),
+                        3, vars1, coefs1,
+                        task_i.duration - M, SCIPinfinity(scip)));
+                    SCIP_CALL(SCIPaddCons(scip, cons1));
+                    SCIP_CALL(SCIPreleaseCons(scip, &cons1));
+
+                    /* y = 0 ⇒ task_j завершается до начала task_i */
+                    SCIP_CONS* cons2 = nullptr;
+                    SCIP_VAR* vars2[] = {
+                        start_vars[task_i.id - 1],
+                        start_vars[task_j.id - 1],
+                        y_var
+                    };
+                    SCIP_Real coefs2[] = {1.0, -1.0, M};
+
+                    SCIP_CALL(SCIPcreateConsBasicLinear(
+                        scip, &cons2,
+                        ("resource_order_" + std::to_string(task_i.id) + "_" +
+                         std::to_string(task_j.id) + "_r" +
+                         std::to_string(r) + "_2").c_str(),
+                        3, vars2, coefs2,
+                        task_j.duration, SCIPinfinity(scip)));
+                    SCIP_CALL(SCIPaddCons(scip, cons2));
+                    SCIP_CALL(SCIPreleaseCons(scip, &cons2));
+
+                    SCIP_CALL(SCIPreleaseVar(scip, &y_var));
+                }
+            }
+        }
+    }
+
+
+
+    /* -----------------------------------------------------------------------
+        2. Ограничения недоступных интервалов ресурсов
+        Каждая задача либо полностью завершается до начала интервала,
+        либо начинается после его окончания
+        ----------------------------------------------------------------------- */
+
+    // resource_unavailability[r] — список временных интервалов [L, U), в которые ресурс r полностью недоступен
+    auto resource_unavailability = options.resource_unavailability;
+
+    for (const auto& task : inst.tasks) {
+        for (int r = 0; r < inst.n_resources; ++r) {
+            int usage = (r < (int)task.resources.size()) ? task.resources[r] : 0;
+            if (usage == 0) continue;
+
+            if (resource_unavailability.find(r) != resource_unavailability.end()) { // если для ресурса r заданы ограничения в resource_unavailability
+                for (const auto& [L, U] : resource_unavailability[r]) {
+
+                    // Бинарная переменная выбора стороны интервала
+                    std::string z_name = "z_" + std::to_string(task.id) +
+                                         "_r" + std::to_string(r) +
+                                         "_" + std::to_string(L) +
+                                         "_" + std::to_string(U);
+                    SCIP_VAR* z_var = nullptr;
+                    SCIP_CALL(SCIPcreateVarBasic(
+                        scip, &z_var, z_name.c_str(),
+                        0.0, 1.0, 0.0, SCIP_VARTYPE_BINARY));
+                    SCIP_CALL(SCIPaddVar(scip, z_var));
+
+                    SCIP_Real M = 0.0;
+                    for (const auto& t : inst.tasks)
+                        M += t.duration;
+                    M += 1000;
+
+                    /* z = 1 ⇒ задача завершается до L */
+                    SCIP_CONS* cons_before = nullptr;
+                    SCIP_VAR* vars_before[] = {
+                        start_vars[task.id - 1],
+                        z_var
+                    };
+                    SCIP_Real coefs_before[] = {1.0, M};
+
+                    SCIP_CALL(SCIPcreateConsBasicLinear(
+                        scip, &cons_before,
+                        ("unavail_before_" + std::to_string(task.id) +
+                         "_r" + std::to_string(r) + "_" +
+                         std::to_string(L)).c_str(),
+                        2, vars_before, coefs_before,
+                        -SCIPinfinity(scip),
+                        L - task.duration + M));
+                    SCIP_CALL(SCIPaddCons(scip, cons_before));
+                    SCIP_CALL(SCIPreleaseCons(scip, &cons_before));
+
+                    /* z = 0 ⇒ задача начинается после U */
+                    SCIP_CONS* cons_after = nullptr;
+                    SCIP_VAR* vars_after[] = {
+                        start_vars[task.id - 1],
+                        z_var
+                    };
+                    SCIP_Real coefs_after[] = {1.0, M};
+
+                    SCIP_CALL(SCIPcreateConsBasicLinear(
+                        scip, &cons_after,
+                        ("unavail_after_" + std::to_string(task.id) +
+                         "_r" + std::to_string(r) + "_" +
+                         std::to_string(U)).c_str(),
+                        2, vars_after, coefs_after,
+                        U, SCIPinfinity(scip)));
+                    SCIP_CALL(SCIPaddCons(scip, cons_after));
+                    SCIP_CALL(SCIPreleaseCons(scip, &cons_after));
+
+                    SCIP_CALL(SCIPreleaseVar(scip, &z_var));
+                }
+            }
+        }
+    }
+
+
+
+    /* ------------------------------------------------------------
+        3. Time-dependent capacity ресурсов
+        capacity[r][t] — ёмкость ресурса r в момент времени t
+        ------------------------------------------------------------ */
+    // число переменных  =  кол-во тасков  x  кол-во моментов времени
+
+    const auto& time_capacity = options.time_capacity;
+
+    // Переменные x_{i,t} = 1  <=>  задача i активна в момент t
+
+    std::map<std::pair<int,int>, SCIP_VAR*> x_vars;
+
+    // Большое M
+    SCIP_Real M = 0.0;
+    for (const auto& t : inst.tasks)
+        M += t.duration;
+    M += 1000;
+
+    // определение индикаторов x_task_t
+    for (const auto& task : inst.tasks) {
+        if (task.duration == 0) continue;
+
+        for (const auto& [r, cap_map] : time_capacity) {        // по всем ресурсам r
+            for (const auto& [t, cap] : cap_map) {      // по всем временам t
+                if (x_vars.count({task.id, t})) continue;   // x_i_t общий для всех ресурсов
+
+                std::string name = "x_" + std::to_string(task.id) +
+                                   "_t" + std::to_string(t);
+
+                SCIP_VAR* x = nullptr;            // x = 1   =>   задача task выполняется в t   ;   x = 0   =>   не выполняется   (оптимизируется SCIP-ом)
+                SCIP_CALL(SCIPcreateVarBasic(
+                    scip, &x, name.c_str(),
+                    0.0, 1.0, 0.0, SCIP_VARTYPE_BINARY));
+                SCIP_CALL(SCIPaddVar(scip, x));
+
+                x_vars[{task.id, t}] = x;
+
+                /* start_i <= t + M*(1-x) */        // задача началась до текущего t
+                SCIP_CONS* c1 = nullptr;
+                SCIP_VAR* v1[] = { start_vars[task.id - 1], x };
+                SCIP_Real a1[] = { 1.0,  M };
+
+                SCIP_CALL(SCIPcreateConsBasicLinear(
+                    scip, &c1, "active_lb",
+                    2, v1, a1,
+                    -SCIPinfinity(scip),
+                    t + M));
+                SCIP_CALL(SCIPaddCons(scip, c1));
+                SCIP_CALL(SCIPreleaseCons(scip, &c1));
+
+                /* start_i + dur_i >= t+1 - M*(1-x) */    // задача закончится после текущего t
+                SCIP_CONS* c2 = nullptr;
+                SCIP_VAR* v2[] = { start_vars[task.id - 1], x };
+                SCIP_Real a2[] = { 1.0, -M };
+
+                SCIP_CALL(SCIPcreateConsBasicLinear(
+                    scip, &c2, "active_ub",
+                    2, v2, a2,
+                    t + 1 - task.duration - M,
+                    SCIPinfinity(scip)));
+                SCIP_CALL(SCIPaddCons(scip, c2));
+                SCIP_CALL(SCIPreleaseCons(scip, &c2));
+            }
+        }
+    }
+
+    // передача ограничений на ресурсы во времени в SCIP
+
+    for (const auto& [r, cap_map] : time_capacity) {
+        for (const auto& [t, cap] : cap_map) {
+
+            SCIP_CONS* cons = nullptr;
+            std::vector<SCIP_VAR*> vars;
+            std::vector<SCIP_Real> coefs;
+
+            for (const auto& task : inst.tasks) {
+                int usage = (r < (int)task.resources.size())  // теоретически задача может использовать ресурс r
+                            ? task.resources[r]
+                            : 0;
+                if (usage == 0 || task.duration == 0) continue;
+
+                auto it = x_vars.find({task.id, t});     // переменная x_i_t
+                if (it == x_vars.end()) continue;
+
+                vars.push_back(it->second);
+                coefs.push_back((SCIP_Real)usage);
+                // sum ( usage_i_r x x_i_t )   -- то есть сколько данного ресурса r используется в t
+            }
+
+            if (!vars.empty()) {
+                SCIP_CALL(SCIPcreateConsBasicLinear(
+                    scip, &cons,
+                    ("cap_r" + std::to_string(r) +
+                     "_t" + std::to_string(t)).c_str(),
+                    vars.size(),
+                    vars.data(),
+                    coefs.data(),
+                    -SCIPinfinity(scip),
+                    cap));
+                    // то есть  -inf  <  sum ( usage_i_r x x_i_t )  <  капасити r
+                SCIP_CALL(SCIPaddCons(scip, cons));
+                SCIP_CALL(SCIPreleaseCons(scip, &cons));
+            }
+        }
+    }
+
+
+
+    return SCIP_OKAY;
+}
+
+SCIP_RETCODE apply_solver_config(SCIP* scip, const SolverConfig& config)
+{
+    if (config.quiet)
+        SCIPsetMessagehdlrQuiet(scip, TRUE);
+
+    /* Сначала emphasis, затем явно заданные группы поверх неё.
+       SCIPsetPresolving/Separating/Heuristics с DEFAULT сбрасывают
+       всю группу, поэтому DEFAULT означает «как задала emphasis» */
+    if (config.emphasis != SCIP_PARAMEMPHASIS_DEFAULT)
+        SCIP_CALL(SCIPsetEmphasis(scip, config.emphasis, TRUE));
+    if (config.presolving != SCIP_PARAMSETTING_DEFAULT)
+        SCIP_CALL(SCIPsetPresolving(scip, config.presolving, TRUE));
+    if (config.separating != SCIP_PARAMSETTING_DEFAULT)
+        SCIP_CALL(SCIPsetSeparating(scip, config.separating, TRUE));
+    if (config.heuristics != SCIP_PARAMSETTING_DEFAULT)
+        SCIP_CALL(SCIPsetHeuristics(scip, config.heuristics, TRUE));
+
+    if (!config.settings_file.empty())
+        SCIP_CALL(SCIPreadParams(scip, config.settings_file.c_str()));
+    for (const auto& [name, value] : config.int_params)
+        SCIP_CALL(SCIPsetIntParam(scip, name.c_str(), value));
+    for (const auto& [name, value] : config.bool_params)
+        SCIP_CALL(SCIPsetBoolParam(scip, name.c_str(), value ? TRUE : FALSE));
+
+    if (config.time_limit > 0)
+        SCIP_CALL(SCIPsetRealParam(scip, "limits/time", config.time_limit));
+    if (config.memory_limit > 0)
+        SCIP_CALL(SCIPsetRealParam(scip, "limits/memory", config.memory_limit));
+
+    return SCIP_OKAY;
+}
+
+/* ===================================================================
+   Полный цикл: модель -> SCIPsolve -> расписание
+   =================================================================== */
+SCIP_RETCODE solve_rcpsp(const RCPSPInstance& inst,
+                         const ModelOptions& options,
+                         const SolverConfig& config,
+                         SolveResult& result)
+{
+    SCIP* scip = nullptr;
+    SCIP_CALL(SCIPcreate(&scip));
+    SCIP_CALL(SCIPincludeDefaultPlugins(scip));
+    SCIP_CALL(apply_solver_config(scip, config));
+
+    std::vector<SCIP_VAR*> start_vars;
+    SCIP_VAR* makespan = nullptr;
+    SCIP_CALL(build_rcpsp_model(scip, inst, options, start_vars, makespan));
+
+    auto t_start = std::chrono::high_resolution_clock::now();
+    SCIP_CALL(SCIPsolve(scip));
+    auto t_end = std::chrono::high_resolution_clock::now();
+
+    result = SolveResult();
+    result.status  = status_name(SCIPgetStatus(scip));
+    result.seconds = std::chrono::duration<double>(t_end - t_start).count();
+
+    SCIP_SOL* sol = SCIPgetBestSol(scip);
+    if (sol) {
+        result.feasible = true;
+        result.makespan = SCIPgetSolVal(scip, sol, makespan);
+        for (int id = 1; id <= inst.n_jobs; ++id)
+            result.starts.emplace_back(id,
+                SCIPgetSolVal(scip, sol, start_vars[id - 1]));
+    }
+
+    for (auto& var : start_vars)
+        SCIP_CALL(SCIPreleaseVar(scip, &var));
+    SCIP_CALL(SCIPreleaseVar(scip, &makespan));
+    SCIP_CALL(SCIPfree(&scip));
+
+    return SCIP_OKAY;
+}
+
+/* ===================================================================
+   Локальная переоптимизация участка расписания
+
+   Модель строится только для свободных задач: задачи вне области —
+   константы. Пары и календарные ограничения добавляются, только если
+   в них есть свободная задача (пары фиксированных задач уже решены),
+   поэтому размер модели зависит от области, а не от всего экземпляра
+   =================================================================== */
+static SCIP_RETCODE add_linear(SCIP* scip, const std::string& name,
+                               std::vector<SCIP_VAR*> vars,
+                               std::vector<SCIP_Real> coefs,
+                               SCIP_Real lhs, SCIP_Real rhs)
+{
+    SCIP_CONS* cons = nullptr;
+    SCIP_CALL(SCIPcreateConsBasicLinear(
+        scip, &cons, name.c_str(),
+        (int)vars.size(), vars.data(), coefs.data(),
+        lhs, rhs));
+    SCIP_CALL(SCIPaddCons(scip, cons));
+    SCIP_CALL(SCIPreleaseCons(scip, &cons));
+    return SCIP_OKAY;
+}
+
+static SCIP_RETCODE add_binary(SCIP* scip, const std::string& name, SCIP_VAR*& var)
+{
+    SCIP_CALL(SCIPcreateVarBasic(scip, &var, name.c_str(), 0.0, 1.0, 0.0, SCIP_VARTYPE_BINARY));
+    SCIP_CALL(SCIPaddVar(scip, var));
+    return SCIP_OKAY;
+}
+
+static int usage_of(const Task& task, int r)
+{
+    return (r < (int)task.resources.size()) ? task.resources[r] : 0;
+}
+
+// start_vars[id - 1] — переменная свободной задачи id, nullptr для фиксированной.
+// start[id - 1] — начало фиксированной задачи
+static SCIP_RETCODE build_region_model(SCIP* scip,
+                                       const RCPSPInstance& inst,
+                                       const ModelOptions& options,
+                                       const std::vector<double>& start,
+                                       const std::vector<bool>& is_free,
+                                       double region_start,
+                                       std::vector<SCIP_VAR*>& start_vars,
+                                       SCIP_VAR*& makespan)
+{
+    SCIP_CALL(SCIPcreateProbBasic(scip, "rcpsp_region"));
+    const SCIP_Real inf = SCIPinfinity(scip);
+    const int n = inst.n_jobs;
+
+    SCIP_Real M = 1000;
+    for (const auto& t : inst.tasks)
+        M += t.duration;
+
+    /* ---------- Границы свободных задач от фиксированных соседей ---------- */
+    std::vector<double> lb(n, region_start), ub(n, inf);
+    double fixed_end = 0.0;
+    for (const auto& t : inst.tasks) {
+        int i = t.id - 1;
+        if (!is_free[i])
+            fixed_end = std::max(fixed_end, start[i] + t.duration);
+        for (int succ : t.successors) {
+            int j = succ - 1;
+            if (is_free[i] && !is_free[j]) ub[i] = std::min(ub[i], start[j] - t.duration);
+            if (!is_free[i] && is_free[j]) lb[j] = std::max(lb[j], start[i] + t.duration);
+        }
+    }
+
+    /* ---------- Переменные ---------- */
+    start_vars.assign(n, nullptr);
+    std::vector<const Task*> free_tasks;
+    for (const auto& t : inst.tasks) {
+        int i = t.id - 1;
+        if (!is_free[i]) continue;
+        free_tasks.push_back(&t);
+
+        SCIP_VAR* var = nullptr;
+        SCIP_CALL(SCIPcreateVarBasic(
+            scip, &var, ("t" + std::to_string(t.id)).c_str(),
+            lb[i], inf, 1e-4, SCIP_VARTYPE_INTEGER));
+        SCIP_CALL(SCIPaddVar(scip, var));
+        start_vars[i] = var;
+    }
+
+    // фиксированные задачи задают нижнюю границу makespan
+    SCIP_CALL(SCIPcreateVarBasic(
+        scip, &makespan, "makespan",
+        fixed_end, inf, 1.0, SCIP_VARTYPE_CONTINUOUS));
+    SCIP_CALL(SCIPaddVar(scip, makespan));
+
+    /* ---------- Предшествование и makespan ---------- */
+    for (const Task* t : free_tasks) {
+        SCIP_VAR* si = start_vars[t->id - 1];
+        SCIP_CALL(add_linear(scip, "makespan", {makespan, si}, {1.0, -1.0}, t->duration, inf));
+
+        for (int succ : t->successors) {
+            if (is_free[succ - 1])
+                SCIP_CALL(add_linear(scip, "prec", {start_vars[succ - 1], si}, {1.0, -1.0},
+                                     t->duration, inf));
+            else
+                SCIP_CALL(add_linear(scip, "prec", {si}, {1.0},
+                                     -inf, start[succ - 1] - t->duration));
+        }
+    }
+
+    /* ---------- 1. Попарные конфликты по ресурсам ---------- */
+    // одна бинарная переменная на пару: порядок задач общий для всех ресурсов
+    auto conflicts = [&](const Task& a, const Task& b) {
+        for (int r = 0; r < inst.n_resources; ++r) {
+            int use_a = usage_of(a, r), use_b = usage_of(b, r);
+            if (use_a > 0 && use_b > 0 && use_a + use_b > inst.resources[r].capacity)
+                return true;
+        }
+        return false;
+    };
+
+    for (const Task* f : free_tasks) {
+        int i = f->id - 1;
+        SCIP_VAR* sf = start_vars[i];
+
+        for (const auto& g : inst.tasks) {
+            int j = g.id - 1;
+            if (j == i || (is_free[j] && j < i)) continue;   // свободная пара — один раз
+            if (!conflicts(*f, g)) continue;
+
+            std::string suffix = std::to_string(f->id) + "_" + std::to_string(g.id);
+            SCIP_VAR* y = nullptr;
+
+            if (is_free[j]) {
+                SCIP_VAR* sg = start_vars[j];
+                SCIP_CALL(add_binary(scip, "y_" + suffix, y));
+                /* y = 1 ⇒ f завершается до начала g, y = 0 ⇒ наоборот */
+                SCIP_CALL(add_linear(scip, "resource_order_" + suffix + "_1",
+                                     {sg, sf, y}, {1.0, -1.0, -M}, f->duration - M, inf));
+                SCIP_CALL(add_linear(scip, "resource_order_" + suffix + "_2",
+                                     {sf, sg, y}, {1.0, -1.0, M}, g.duration, inf));
+            } else {
+                // g — константа: нужен ли выбор стороны при текущих границах f
+                if (f->duration == 0 || g.duration == 0) continue;
+                if (start[j] + g.duration <= lb[i]) continue;
+                if (ub[i] + f->duration <= start[j]) continue;
+
+                SCIP_CALL(add_binary(scip, "y_" + suffix, y));
+                /* y = 1 ⇒ f завершается до начала g */
+                SCIP_CALL(add_linear(scip, "resource_order_" + suffix + "_1",
+                                     {sf, y}, {1.0, M}, -inf, start[j] - f->duration + M));
+                /* y = 0 ⇒ f начинается после конца g */
+                SCIP_CALL(add_linear(scip, "resource_order_" + suffix + "_2",
+                                     {sf, y}, {1.0, M}, start[j] + g.duration, inf));
+            }
+            SCIP_CALL(SCIPreleaseVar(scip, &y));
+        }
+    }
+
+    /* ---------- 2. Недоступные интервалы ресурсов ---------- */
+    for (const Task* f : free_tasks) {
+        int i = f->id - 1;
+        SCIP_VAR* sf = start_vars[i];
+
+        for (const auto& [r, intervals] : options.resource_unavailability) {
+            if (r >= inst.n_resources || usage_of(*f, r) == 0) continue;
+
+            for (const auto& [L, U] : intervals) {
+                if (U <= lb[i]) continue;   // интервал целиком до начала задачи
+
+                std::string suffix = std::to_string(f->id) + "_r" + std::to_string(r) +
+                                     "_" + std::to_string(L);
+                SCIP_VAR* z = nullptr;
+                SCIP_CALL(add_binary(scip, "z_" + suffix + "_" + std::to_string(U), z));
+                /* z = 1 ⇒ задача завершается до L, z = 0 ⇒ начинается после U */
+                SCIP_CALL(add_linear(scip, "unavail_before_" + suffix,
+                                     {sf, z}, {1.0, M}, -inf, L - f->duration + M));
+                SCIP_CALL(add_linear(scip, "unavail_after_" + suffix,
+                                     {sf, z}, {1.0, M}, U, inf));
+                SCIP_CALL(SCIPreleaseVar(scip, &z));
+            }
+        }
+    }
+
+    /* ---------- 3. Ёмкость ресурсов по моментам времени ---------- */
+    // x_i_t = 1 <=> свободная задача i выполняется в момент t: вместе с
+    // b (закончилась до t) и a (начнётся после t) ровно один из трёх
+    std::map<std::pair<int, int>, SCIP_VAR*> x_vars;
+    auto active_var = [&](const Task& task, int t, SCIP_VAR*& x) -> SCIP_RETCODE {
+        auto it = x_vars.find({task.id, t});
+        if (it != x_vars.end()) {
+            x = it->second;
+            return SCIP_OKAY;
+        }
+        SCIP_VAR* sf = start_vars[task.id - 1];
+        std::string suffix = std::to_string(task.id) + "_t" + std::to_string(t);
+        SCIP_VAR* before = nullptr;
+        SCIP_VAR* after = nullptr;
+        SCIP_CALL(add_binary(scip, "x_" + suffix, x));
+        SCIP_CALL(add_binary(scip, "b_" + suffix, before));
+        SCIP_CALL(add_binary(scip, "a_" + suffix, after));
+
+        SCIP_CALL(add_linear(scip, "active_one", {x, before, after}, {1.0, 1.0, 1.0}, 1.0, 1.0));
+        SCIP_CALL(add_linear(scip, "active_lb", {sf, x}, {1.0, M}, -inf, t + M));
+        SCIP_CALL(add_linear(scip, "active_ub", {sf, x}, {1.0, -M}, t + 1 - task.duration - M, inf));
+        SCIP_CALL(add_linear(scip, "done_before", {sf, before}, {1.0, M}, -inf, t - task.duration + M));
+        SCIP_CALL(add_linear(scip, "start_after", {sf, after}, {1.0, -M}, t + 1 - M, inf));
+
+        SCIP_CALL(SCIPreleaseVar(scip, &before));
+        SCIP_CALL(SCIPreleaseVar(scip, &after));
+        x_vars[{task.id, t}] = x;
+        return SCIP_OKAY;
+    };
+
+    for (const auto& [r, cap_map] : options.time_capacity) {
+        if (r >= inst.n_resources) continue;
+
+        for (const auto& [t, cap] : cap_map) {
+            int fixed_usage = 0;
+            std::vector<SCIP_VAR*> vars;
+            std::vector<SCIP_Real> coefs;
+
+            for (const auto& task : inst.tasks) {
+                int usage = usage_of(task, r);
+                int i = task.id - 1;
+                if (usage == 0 || task.duration == 0) continue;
+
+                if (!is_free[i]) {
+                    if (start[i] <= t && t < start[i] + task.duration)
+                        fixed_usage += usage;
+                } else if (t >= lb[i]) {
+                    SCIP_VAR* x = nullptr;
+                    SCIP_CALL(active_var(task, t, x));
+                    vars.push_back(x);
+                    coefs.push_back((SCIP_Real)usage);
+                }
+            }
+
+            // перегрузку одними фиксированными задачами область не исправит
+            if (!vars.empty())
+                SCIP_CALL(add_linear(scip, "cap_r" + std::to_string(r) + "_t" + std::to_string(t),
+                                     vars, coefs, -inf, std::max(0, cap - fixed_usage)));
+        }
+    }
+    for (auto& [key, x] : x_vars)
+        SCIP_CALL(SCIPreleaseVar(scip, &x));
+
+    return SCIP_OKAY;
+}
+
+SCIP_RETCODE solve_rcpsp_region(const RCPSPInstance& inst,
+                                const ModelOptions& options,
+                                const SolverConfig& config,
+                                const std::vector<std::pair<int, double>>& starts,
+                                const std::vector<int>& free_tasks,
+                                SolveResult& result)
+{
+    SCIP* scip = nullptr;
+    SCIP_CALL(SCIPcreate(&scip));
+    SCIP_CALL(SCIPincludeDefaultPlugins(scip));
+    SCIP_CALL(apply_solver_config(scip, config));
+
+    /* ---------- Область ---------- */
+    std::vector<bool> is_free(inst.n_jobs, false);
+    for (int id : free_tasks)
+        if (id >= 1 && id <= inst.n_jobs)
+            is_free[id - 1] = true;
+
+    std::vector<double> start(inst.n_jobs, 0.0);
+    for (const auto& [id, value] : starts)
+        start[id - 1] = value;
+
+    // свободные задачи не уходят левее начала области
+    double region_start = SCIPinfinity(scip);
+    for (int i = 0; i < inst.n_jobs; ++i)
+        if (is_free[i])
+            region_start = std::min(region_start, start[i]);
+
+    std::vector<SCIP_VAR*> start_vars;
+    SCIP_VAR* makespan = nullptr;
+    SCIP_CALL(build_region_model(scip, inst, options, start, is_free, region_start,
+                                 start_vars, makespan));
+
+    /* ---------- Текущее расписание как стартовое ---------- */
+    SCIP_SOL* partial = nullptr;
+    SCIP_Bool stored = FALSE;
+    SCIP_CALL(SCIPcreatePartialSol(scip, &partial, nullptr));
+    for (int i = 0; i < inst.n_jobs; ++i)
+        if (start_vars[i])
+            SCIP_CALL(SCIPsetSolVal(scip, partial, start_vars[i], start[i]));
+    SCIP_CALL(SCIPaddSolFree(scip, &partial, &stored));
+
+    auto t_start = std::chrono::high_resolution_clock::now();
+    SCIP_CALL(SCIPsolve(scip));
+    auto t_end = std::chrono::high_resolution_clock::now();
+
+    result = SolveResult();
+    result.status  = status_name(SCIPgetStatus(scip));
+    result.seconds = std::chrono::duration<double>(t_end - t_start).count();
+
+    SCIP_SOL* sol = SCIPgetBestSol(scip);
+    if (sol) {
+        result.feasible = true;
+        result.makespan = SCIPgetSolVal(scip, sol, makespan);
+        for (int id = 1; id <= inst.n_jobs; ++id)
+            result.starts.emplace_back(id, start_vars[id - 1]
+                ? SCIPgetSolVal(scip, sol, start_vars[id - 1])
+                : start[id - 1]);
+    }
+
+    for (auto& var : start_vars)
+        if (var) SCIP_CALL(SCIPreleaseVar(scip, &var));
+    SCIP_CALL(SCIPreleaseVar(scip, &makespan));
+    SCIP_CALL(SCIPfree(&scip));
+
+    return SCIP_OKAY;
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include "scip/scip.h"
+#include "rcpsp_parser.h"
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Дополнительные ограничения модели, которых нет в PSPLIB-файле
+struct ModelOptions {
+    // resource_unavailability[r] — интервалы [L, U), в которые ресурс r полностью недоступен
+    std::map<int, std::vector<std::pair<int,int>>> resource_unavailability;
+    // time_capacity[r][t] — ёмкость ресурса r в момент времени t
+    std::map<int, std::map<int, int>> time_capacity;
+};
+
+// Календари, с которыми до сих пор решалась модель в main_scip.cpp
+ModelOptions default_model_options();
+
+// Настройки SCIP для одного запуска
+struct SolverConfig {
+    std::string name = "default";
+    double time_limit   = 0.0;   // секунды, 0 — без ограничения
+    double memory_limit = 0.0;   // МБ, 0 — без ограничения
+    // presolving/separating/heuristics, отличные от DEFAULT, перекрывают emphasis
+    SCIP_PARAMSETTING  presolving = SCIP_PARAMSETTING_DEFAULT;
+    SCIP_PARAMSETTING  separating = SCIP_PARAMSETTING_DEFAULT;
+    SCIP_PARAMSETTING  heuristics = SCIP_PARAMSETTING_DEFAULT;
+    SCIP_PARAMEMPHASIS emphasis   = SCIP_PARAMEMPHASIS_DEFAULT;
+    std::vector<std::pair<std::string, int>>  int_params;    // отдельные параметры SCIP
+    std::vector<std::pair<std::string, bool>> bool_params;
+    std::string settings_file;   // .set-файл (например, от --tune), читается после emphasis
+    bool quiet = false;          // без вывода SCIP
+};
+
+struct SolveResult {
+    std::string status;          // "optimal", "timelimit", "infeasible", ...
+    bool   feasible = false;
+    double makespan = 0.0;
+    double seconds  = 0.0;
+    bool   from_cache = false;   // расписание взято из ModelCache без запуска SCIP
+    std::vector<std::pair<int, double>> starts;   // (id задачи, начало)
+};
+
+// Создаёт задачу в scip и добавляет все переменные и ограничения RCPSP.
+// start_vars[id - 1] — переменная начала задачи id
+SCIP_RETCODE build_rcpsp_model(SCIP* scip,
+                               const RCPSPInstance& inst,
+                               const ModelOptions& options,
+                               std::vector<SCIP_VAR*>& start_vars,
+                               SCIP_VAR*& makespan);
+
+SCIP_RETCODE apply_solver_config(SCIP* scip, const SolverConfig& config);
+
+// Строит модель, решает её и освобождает SCIP
+SCIP_RETCODE solve_rcpsp(const RCPSPInstance& inst,
+                         const ModelOptions& options,
+                         const SolverConfig& config,
+                         SolveResult& result);
+
+// Переоптимизирует только задачи free_tasks (id); остальные — константы
+// на своих началах из starts. Модель содержит переменные и ограничения
+// только для свободных задач и их пар с задачами, которые они могут задеть
+SCIP_RETCODE solve_rcpsp_region(const RCPSPInstance& inst,
+                                const ModelOptions& options,
+                                const SolverConfig& config,
+                                const std::vector<std::pair<int, double>>& starts,
+                                const std::vector<int>& free_tasks,
+                                SolveResult& result);
+
+std::string status_name(SCIP_STATUS status);
@@ -0,0 +1,256 @@
+#include "rcpsp_tuning.h"
+#include "experiment_runner.h"
+#include "rcpsp_hash.h"
+#include "scip/scipdefplugins.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+
+namespace fs = std::filesystem;
+
+/* ===================================================================
+   Пространство поиска
+   =================================================================== */
+static const SCIP_PARAMSETTING SETTINGS[] = {
+    SCIP_PARAMSETTING_DEFAULT,
+    SCIP_PARAMSETTING_FAST,
+    SCIP_PARAMSETTING_AGGRESSIVE,
+    SCIP_PARAMSETTING_OFF
+};
+static const char SETTING_CODE[] = { 'd', 'f', 'a', 'o' };
+
+static const SCIP_PARAMEMPHASIS EMPHASES[] = {
+    SCIP_PARAMEMPHASIS_DEFAULT,
+    SCIP_PARAMEMPHASIS_OPTIMALITY,
+    SCIP_PARAMEMPHASIS_CPSOLVER,
+    SCIP_PARAMEMPHASIS_EASYCIP
+};
+static const char EMPHASIS_CODE[] = { 'd', 'o', 'c', 'e' };
+
+// Точка сетки: индексы presolving, separating, heuristics, emphasis,
+// branching/preferbinary, conflict/enable.
+// emphasis задаёт базу, p/s/h не 'd' перекрывают её группы (apply_solver_config)
+static SolverConfig make_candidate(int p, int s, int h, int e, int b, int c)
+{
+    SolverConfig config;
+    config.presolving = SETTINGS[p];
+    config.separating = SETTINGS[s];
+    config.heuristics = SETTINGS[h];
+    config.emphasis   = EMPHASES[e];
+
+    // порядок задач задают бинарные y/z — ветвление по ним в первую очередь
+    if (b) config.bool_params.emplace_back("branching/preferbinary", true);
+    // конфликтный анализ на дизъюнкциях big-M часто только тратит время
+    if (c) config.bool_params.emplace_back("conflict/enable", false);
+
+    config.name = std::string("p") + SETTING_CODE[p] +
+                  "_s" + SETTING_CODE[s] +
+                  "_h" + SETTING_CODE[h] +
+                  "_e" + EMPHASIS_CODE[e] +
+                  "_b" + std::to_string(b) +
+                  "_c" + std::to_string(c);
+    return config;
+}
+
+std::vector<SolverConfig> tuning_candidates(int n, unsigned seed)
+{
+    const int grid_size = 4 * 4 * 4 * 4 * 2 * 2;
+    n = std::clamp(n, 1, grid_size);
+
+    std::vector<SolverConfig> candidates;
+    candidates.push_back(make_candidate(0, 0, 0, 0, 0, 0));
+
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> pick(1, grid_size - 1);
+    std::set<int> used = {0};
+
+    while ((int)candidates.size() < n) {
+        int code = pick(rng);
+        if (!used.insert(code).second) continue;
+
+        int k = code;
+        int p = k % 4; k /= 4;
+        int s = k % 4; k /= 4;
+        int h = k % 4; k /= 4;
+        int e = k % 4; k /= 4;
+        int b = k % 2; k /= 2;
+        int c = k % 2;
+        candidates.push_back(make_candidate(p, s, h, e, b, c));
+    }
+    return candidates;
+}
+
+/* ===================================================================
+   Racing
+   =================================================================== */
+
+// Средние ранги по экземпляру (меньше — лучше, ничьи делят ранг)
+static std::vector<double> rank_scores(const std::vector<double>& scores)
+{
+    std::vector<int> order(scores.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = (int)i;
+    std::sort(order.begin(), order.end(),
+              [&](int a, int b) { return scores[a] < scores[b]; });
+
+    std::vector<double> ranks(scores.size());
+    size_t i = 0;
+    while (i < order.size()) {
+        size_t j = i;
+        while (j + 1 < order.size() && scores[order[j + 1]] == scores[order[i]]) ++j;
+        double rank = (i + j) / 2.0 + 1.0;
+        for (size_t k = i; k <= j; ++k) ranks[order[k]] = rank;
+        i = j + 1;
+    }
+    return ranks;
+}
+
+SolverConfig tuned_config(const fs::path& settings_file)
+{
+    std::ifstream fin(settings_file, std::ios::binary);
+    std::stringstream ss;
+    ss << fin.rdbuf();
+
+    SolverConfig config;
+    config.name = "tuned_" + hash_hex(fnv1a_64(ss.str()), 8);
+    config.settings_file = settings_file.string();
+    return config;
+}
+
+int run_tuning(const TuningOptions& options)
+{
+    if (options.time_limit <= 0) {
+        std::cerr << "Для подбора нужен положительный лимит времени на запуск\n";
+        return 1;
+    }
+
+    /* ---------- Обучающая выборка ---------- */
+    std::vector<std::string> files;
+    try {
+        files = list_instances(options.train_dir);
+    } catch (const std::exception& e) {
+        std::cerr << "Ошибка доступа к директории: " << e.what() << "\n";
+        return 1;
+    }
+
+    std::mt19937 rng(options.seed);
+    std::shuffle(files.begin(), files.end(), rng);
+
+    std::vector<RCPSPInstance> train;
+    for (const auto& file : files) {
+        if ((int)train.size() >= options.max_instances) break;
+        try {
+            train.push_back(parse_sm_file((options.train_dir / file).string()));
+        } catch (...) {
+            std::cerr << "Пропускаю " << file << ": ошибка чтения SM-файла\n";
+        }
+    }
+    if (train.empty()) {
+        std::cerr << "Нет обучающих SM-файлов\n";
+        return 1;
+    }
+
+    /* ---------- Гонка ---------- */
+    std::vector<SolverConfig> candidates = tuning_candidates(options.n_candidates, options.seed);
+    std::vector<bool>   alive(candidates.size(), true);
+    std::vector<double> rank_sum(candidates.size(), 0.0);
+    int stages = 0;
+
+    // PAR10: нерешённый до оптимума запуск стоит 10 лимитов времени.
+    // Запуск, остановленный adaptive capping, — такой же отказ: иначе
+    // оценка зависела бы от порядка запуска кандидатов, и урезанный
+    // нерешённый запуск обгонял бы решённый
+    const double penalty = 10.0 * options.time_limit;
+
+    for (size_t n = 0; n < train.size(); ++n) {
+        std::vector<int> racing;
+        for (size_t c = 0; c < candidates.size(); ++c)
+            if (alive[c]) racing.push_back((int)c);
+        if (racing.size() <= 1) break;
+
+        std::vector<double> scores;
+        double best = options.time_limit;
+
+        for (int c : racing) {
+            SolverConfig config = candidates[c];
+            config.quiet = true;
+            // adaptive capping: дольше, чем вдвое хуже лучшего, ждать незачем
+            config.time_limit = std::min(options.time_limit, 2.0 * best + 1.0);
+
+            SolveResult result;
+            double score = penalty;
+            if (solve_rcpsp(train[n], options.model_options, config, result) == SCIP_OKAY) {
+                if (result.status == "optimal") {
+                    score = result.seconds;
+                    best = std::min(best, result.seconds);
+                }
+            }
+            scores.push_back(score);
+        }
+
+        std::vector<double> ranks = rank_scores(scores);
+        for (size_t k = 0; k < racing.size(); ++k)
+            rank_sum[racing[k]] += ranks[k];
+        ++stages;
+
+        /* --- Отсев --- */
+        // разность средних рангов двух равных конфигураций имеет
+        // дисперсию примерно (m^2 - 1) / (6 * stages), m — число участников
+        if (stages >= options.min_stages) {
+            double m = (double)racing.size();
+            double threshold = options.z_value * std::sqrt((m * m - 1.0) / (6.0 * stages));
+
+            double best_mean = 1e300;
+            for (int c : racing)
+                best_mean = std::min(best_mean, rank_sum[c] / stages);
+
+            for (int c : racing) {
+                if (rank_sum[c] / stages - best_mean > threshold) {
+                    alive[c] = false;
+                    std::cout << "  выбыл " << candidates[c].name << "\n";
+                }
+            }
+        }
+
+        int left = (int)std::count(alive.begin(), alive.end(), true);
+        std::cout << "Экземпляр " << n + 1 << "/" << train.size()
+                  << ": осталось " << left << " конфигураций\n";
+        std::cout.flush();
+    }
+
+    /* ---------- Победитель ---------- */
+    int winner = -1;
+    for (size_t c = 0; c < candidates.size(); ++c)
+        if (alive[c] && (winner < 0 || rank_sum[c] < rank_sum[winner]))
+            winner = (int)c;
+
+    std::cout << "Лучшая конфигурация: " << candidates[winner].name;
+    if (stages > 0)
+        std::cout << " (средний ранг " << rank_sum[winner] / stages << ")";
+    std::cout << "\n";
+
+    // .set без лимитов: время и память задаются при запуске
+    SolverConfig best = candidates[winner];
+    best.quiet = true;
+    best.time_limit = 0.0;
+    best.memory_limit = 0.0;
+
+    SCIP* scip = nullptr;
+    if (SCIPcreate(&scip) != SCIP_OKAY ||
+        SCIPincludeDefaultPlugins(scip) != SCIP_OKAY ||
+        apply_solver_config(scip, best) != SCIP_OKAY ||
+        SCIPwriteParams(scip, options.output.c_str(), TRUE, TRUE) != SCIP_OKAY) {
+        std::cerr << "Не удалось записать " << options.output << "\n";
+        if (scip) SCIPfree(&scip);
+        return 1;
+    }
+    SCIPfree(&scip);
+
+    std::cout << "Настройки записаны в " << options.output << "\n";
+    return 0;
+}
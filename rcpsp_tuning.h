@@ -0,0 +1,37 @@
+#pragma once
+#include "rcpsp_model.h"
+
+#include <filesystem>
+#include <vector>
+
+/* ===================================================================
+   Подбор параметров SCIP для RCPSP (racing)
+
+   Кандидаты — комбинации presolving / separating / heuristics /
+   emphasis и нескольких параметров, важных для big-M модели RCPSP.
+   Все живые кандидаты решают обучающие экземпляры по очереди; после
+   min_stages экземпляров кандидаты, чей средний ранг значимо хуже
+   лучшего, выбывают. Победитель записывается в .set-файл, который
+   читается через SolverConfig::settings_file.
+   =================================================================== */
+struct TuningOptions {
+    std::filesystem::path train_dir;   // обучающие SM-файлы (рекурсивно)
+    std::filesystem::path output;      // куда записать .set победителя
+    ModelOptions model_options;
+    int max_instances = 20;            // обучающая выборка из train_dir
+    int n_candidates  = 24;            // включая настройки по умолчанию
+    double time_limit = 30.0;          // секунды на один запуск
+    int min_stages    = 3;             // экземпляров до первого отсева
+    double z_value    = 1.64;          // строгость отсева (односторонний уровень ~5%)
+    unsigned seed     = 1;
+};
+
+// Случайная выборка конфигураций из сетки, первая — SCIP по умолчанию
+std::vector<SolverConfig> tuning_candidates(int n, unsigned seed);
+
+// Конфигурация из .set-файла; имя включает хэш содержимого, поэтому
+// после нового --tune в --sweep появляются новые ячейки, а не «уже решённые»
+SolverConfig tuned_config(const std::filesystem::path& settings_file);
+
+// Возвращает 0, если .set-файл записан; time_limit должен быть > 0
+int run_tuning(const TuningOptions& options);
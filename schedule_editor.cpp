@@ -0,0 +1,420 @@
+#include "schedule_editor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+
+ScheduleEditor::ScheduleEditor(const RCPSPInstance& inst,
+                               const ModelOptions& options,
+                               const std::vector<std::pair<int, double>>& starts)
+    : inst(inst),
+      options(options),
+      n(inst.n_jobs),
+      deadline_time(0)
+{
+    dur.assign(n, 0);
+    req.assign(n, std::vector<int>(inst.n_resources, 0));
+    preds.assign(n, {});
+    succs.assign(n, {});
+    task_start.assign(n, 0);
+    es.assign(n, 0);
+    ls.assign(n, 0);
+    pin.assign(n, -1);
+    conflict.assign(n, 0);
+    redraw_mark.assign(n, 0);
+    moved_mark.assign(n, 0);
+
+    /* --- Граф предшествования (индексы по id, а не по порядку в inst.tasks) --- */
+    for (const auto& task : inst.tasks) {
+        int i = task.id - 1;
+        dur[i] = task.duration;
+        for (int r = 0; r < inst.n_resources && r < (int)task.resources.size(); ++r)
+            req[i][r] = task.resources[r];
+        for (int s : task.successors) {
+            succs[i].push_back(s - 1);
+            preds[s - 1].push_back(i);
+        }
+    }
+
+    /* --- Топологический порядок (алгоритм Кана) --- */
+    topo.assign(n, n);
+    std::vector<int> indeg(n, 0);
+    for (int i = 0; i < n; ++i) indeg[i] = (int)preds[i].size();
+    std::vector<int> order;
+    for (int i = 0; i < n; ++i)
+        if (indeg[i] == 0) order.push_back(i);
+    for (size_t k = 0; k < order.size(); ++k) {
+        int i = order[k];
+        topo[i] = (int)k;
+        for (int s : succs[i])
+            if (--indeg[s] == 0) order.push_back(s);
+    }
+
+    /* --- Начальное расписание и профиль ресурсов --- */
+    usage.assign(inst.n_resources, {});
+    cap.assign(inst.n_resources, {});
+    over.assign(inst.n_resources, {});
+
+    for (const auto& [id, start] : starts) {
+        int i = id - 1;
+        task_start[i] = std::max(0, (int)std::lround(start));
+        deadline_time = std::max(deadline_time, task_start[i] + dur[i]);
+    }
+    ensure_horizon(deadline_time + 1);
+
+    for (int i = 0; i < n; ++i)
+        change_usage(i, task_start[i], task_start[i] + dur[i], +1);
+
+    /* --- Полный CPM: прямой и обратный проходы --- */
+    for (int i : order)
+        es[i] = forward_es(i);
+    for (auto it = order.rbegin(); it != order.rend(); ++it)
+        ls[*it] = backward_ls(*it);
+
+    for (int i = 0; i < n; ++i)
+        conflict[i] = check_conflict(i);
+
+    for (int t : dirty_times) time_mark[t] = 0;
+    dirty_times.clear();
+}
+
+/* ===================================================================
+   Профиль ресурсов
+   =================================================================== */
+int ScheduleEditor::capacity_at(int r, int t) const
+{
+    auto un = options.resource_unavailability.find(r);
+    if (un != options.resource_unavailability.end())
+        for (const auto& [L, U] : un->second)
+            if (t >= L && t < U) return 0;
+
+    auto tc = options.time_capacity.find(r);
+    if (tc != options.time_capacity.end()) {
+        auto it = tc->second.find(t);
+        if (it != tc->second.end()) return it->second;
+    }
+    return inst.resources[r].capacity;
+}
+
+void ScheduleEditor::ensure_horizon(int t)
+{
+    int old = horizon();
+    if (t <= old) return;
+    int size = std::max(t, old * 2);
+
+    for (int r = 0; r < inst.n_resources; ++r) {
+        usage[r].resize(size, 0);
+        over[r].resize(size, 0);
+        cap[r].resize(size);
+        for (int k = old; k < size; ++k)
+            cap[r][k] = capacity_at(r, k);
+    }
+    n_over.resize(size, 0);
+    active.resize(size);
+    time_mark.resize(size, 0);
+}
+
+bool ScheduleEditor::overloaded_at(int t) const
+{
+    return t >= 0 && t < horizon() && n_over[t] > 0;
+}
+
+// Добавляет (sign = +1) или убирает (sign = -1) задачу i на интервале [from, to)
+void ScheduleEditor::change_usage(int i, int from, int to, int sign)
+{
+    if (from >= to) return;
+    ensure_horizon(to);
+
+    for (int t = from; t < to; ++t) {
+        auto& bucket = active[t];
+        if (sign > 0) {
+            bucket.push_back(i);
+        } else {
+            auto it = std::find(bucket.begin(), bucket.end(), i);
+            if (it != bucket.end()) {
+                *it = bucket.back();
+                bucket.pop_back();
+            }
+        }
+
+        for (int r = 0; r < inst.n_resources; ++r) {
+            if (req[i][r] == 0) continue;
+            usage[r][t] += sign * req[i][r];
+            char now = usage[r][t] > cap[r][t];
+            if (now != over[r][t]) {
+                n_over[t] += now ? 1 : -1;
+                over[r][t] = now;
+            }
+        }
+
+        if (!time_mark[t]) {
+            time_mark[t] = 1;
+            dirty_times.push_back(t);
+        }
+    }
+}
+
+bool ScheduleEditor::check_conflict(int i) const
+{
+    for (int t = task_start[i]; t < task_start[i] + dur[i]; ++t) {
+        if (n_over[t] == 0) continue;
+        for (int r = 0; r < inst.n_resources; ++r)
+            if (req[i][r] > 0 && over[r][t]) return true;
+    }
+    return false;
+}
+
+/* ===================================================================
+   CPM
+   =================================================================== */
+int ScheduleEditor::forward_es(int i) const
+{
+    int value = std::max(pin[i], 0);
+    for (int p : preds[i])
+        value = std::max(value, es[p] + dur[p]);
+    return value;
+}
+
+int ScheduleEditor::backward_ls(int i) const
+{
+    int value = deadline_time - dur[i];
+    for (int s : succs[i])
+        value = std::min(value, ls[s] - dur[i]);
+    if (pin[i] >= 0)
+        value = std::min(value, pin[i]);
+    return value;
+}
+
+void ScheduleEditor::set_pin(int i, int value)
+{
+    if (pin[i] == value) return;
+    pin[i] = value;
+    pin_changed.push_back(i);
+}
+
+// Пересчёт ES по конусу последователей и LS по конусу предшественников
+// задач из pin_changed; в changed попадают задачи, у которых что-то изменилось
+void ScheduleEditor::propagate_cpm(std::vector<int>& changed)
+{
+    // каждая задача извлекается после всех предшественников (прямой проход)
+    // или всех последователей (обратный), поэтому в очередь попадает один раз
+    std::vector<char> queued(n, 0);
+
+    using Item = std::pair<int, int>;   // (topo, задача)
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item>> forward;
+    for (int i : pin_changed)
+        if (!queued[i]) { queued[i] = 1; forward.push({topo[i], i}); }
+
+    while (!forward.empty()) {
+        int i = forward.top().second;
+        forward.pop();
+        queued[i] = 0;
+
+        int value = forward_es(i);
+        if (value == es[i]) continue;   // дальше не распространяется
+        es[i] = value;
+        changed.push_back(i);
+        for (int s : succs[i])
+            if (!queued[s]) { queued[s] = 1; forward.push({topo[s], s}); }
+    }
+
+    std::priority_queue<Item> backward;
+    for (int i : pin_changed)
+        if (!queued[i]) { queued[i] = 1; backward.push({topo[i], i}); }
+
+    while (!backward.empty()) {
+        int i = backward.top().second;
+        backward.pop();
+        queued[i] = 0;
+
+        int value = backward_ls(i);
+        if (value == ls[i]) continue;
+        ls[i] = value;
+        changed.push_back(i);
+        for (int p : preds[i])
+            if (!queued[p]) { queued[p] = 1; backward.push({topo[p], p}); }
+    }
+
+    pin_changed.clear();
+}
+
+/* ===================================================================
+   Сдвиги задач
+   =================================================================== */
+int ScheduleEditor::ready_time(int i) const
+{
+    int ready = 0;
+    for (int p : preds[i])
+        ready = std::max(ready, task_start[p] + dur[p]);
+    return ready;
+}
+
+void ScheduleEditor::place(int i, int new_start)
+{
+    change_usage(i, task_start[i], task_start[i] + dur[i], -1);
+    task_start[i] = new_start;
+    change_usage(i, new_start, new_start + dur[i], +1);
+
+    shifted.push_back(i);
+    if (!moved_mark[i]) {
+        moved_mark[i] = 1;
+        moved.push_back(i);
+    }
+}
+
+void ScheduleEditor::begin_update()
+{
+    shifted.clear();
+    dirty_times.clear();
+    pin_changed.clear();
+}
+
+// Пересчёт CPM от изменённых закреплений и конфликтов у задач,
+// выполняющихся в изменённые моменты времени
+std::vector<int> ScheduleEditor::end_update()
+{
+    std::vector<int> redraw;
+    auto add = [&](int k) {
+        if (!redraw_mark[k]) {
+            redraw_mark[k] = 1;
+            redraw.push_back(k);
+        }
+    };
+
+    for (int i : shifted) add(i);
+
+    std::vector<int> cpm_changed;
+    propagate_cpm(cpm_changed);
+    for (int i : cpm_changed) add(i);
+
+    dirty_from = 0;
+    dirty_to = -1;
+    for (int t : dirty_times) {
+        time_mark[t] = 0;
+        for (int k : active[t]) add(k);
+
+        if (dirty_to < dirty_from) dirty_from = dirty_to = t;
+        dirty_from = std::min(dirty_from, t);
+        dirty_to   = std::max(dirty_to, t);
+    }
+
+    std::vector<int> ids;
+    ids.reserve(redraw.size());
+    for (int k : redraw) {
+        conflict[k] = check_conflict(k);
+
+        redraw_mark[k] = 0;
+        ids.push_back(k + 1);
+    }
+
+    shifted.clear();
+    dirty_times.clear();
+    return ids;
+}
+
+bool ScheduleEditor::last_dirty_range(int& from, int& to) const
+{
+    from = dirty_from;
+    to = dirty_to;
+    return dirty_from <= dirty_to;
+}
+
+std::vector<int> ScheduleEditor::move_task(int id, int new_start)
+{
+    int i = id - 1;
+    if (i < 0 || i >= n) return {};
+
+    new_start = std::max(new_start, ready_time(i));
+    if (new_start == task_start[i]) return {};
+
+    begin_update();
+    place(i, new_start);
+    set_pin(i, new_start);
+
+    // последователи в топологическом порядке: каждая задача обрабатывается
+    // после всех своих сдвинутых предшественников
+    using Item = std::pair<int, int>;   // (topo, задача)
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item>> queue;
+    for (int s : succs[i]) queue.push({topo[s], s});
+
+    while (!queue.empty()) {
+        int j = queue.top().second;
+        queue.pop();
+
+        int need = ready_time(j);
+        if (task_start[j] >= need) continue;   // дальше сдвиг не распространяется
+
+        place(j, need);
+        if (pin[j] >= 0) set_pin(j, need);   // закреплённую задачу толкнули
+        for (int s : succs[j]) queue.push({topo[s], s});
+    }
+
+    return end_update();
+}
+
+std::vector<int> ScheduleEditor::assign(const std::vector<std::pair<int, double>>& starts)
+{
+    begin_update();
+    for (const auto& [id, start] : starts) {
+        int i = id - 1;
+        if (i < 0 || i >= n) continue;
+        int value = std::max(0, (int)std::lround(start));
+        if (value != task_start[i]) {
+            place(i, value);
+            if (pin[i] >= 0) set_pin(i, value);
+        }
+    }
+    return end_update();
+}
+
+/* ===================================================================
+   Область для переоптимизации
+   =================================================================== */
+std::vector<int> ScheduleEditor::changed_region() const
+{
+    if (moved.empty()) return {};
+
+    int lo = task_start[moved[0]];
+    int hi = lo;
+    for (int i : moved) {
+        lo = std::min(lo, task_start[i]);
+        hi = std::max(hi, task_start[i] + dur[i]);
+    }
+
+    std::vector<char> mark(n, 0);
+    std::vector<int> ids;
+    for (int i : moved) {
+        mark[i] = 1;
+        ids.push_back(i + 1);
+    }
+    for (int t = lo; t < hi && t < horizon(); ++t) {
+        for (int k : active[t]) {
+            if (!mark[k]) {
+                mark[k] = 1;
+                ids.push_back(k + 1);
+            }
+        }
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+std::vector<int> ScheduleEditor::clear_changed()
+{
+    begin_update();
+    for (int i : moved) {
+        moved_mark[i] = 0;
+        set_pin(i, -1);
+    }
+    moved.clear();
+    return end_update();
+}
+
+std::vector<std::pair<int, double>> ScheduleEditor::schedule() const
+{
+    std::vector<std::pair<int, double>> result;
+    for (int i = 0; i < n; ++i)
+        result.emplace_back(i + 1, (double)task_start[i]);
+    return result;
+}
@@ -0,0 +1,107 @@
+#pragma once
+#include "rcpsp_model.h"
+
+#include <utility>
+#include <vector>
+
+/* ===================================================================
+   Редактируемое расписание для интерактивной диаграммы Ганта
+
+   Все пересчёты инкрементальные — трогают только сдвинутые задачи,
+   их соседей по предшествованию и затронутые моменты времени:
+   - сдвиг задачи вправо толкает последователей (обход в
+     топологическом порядке, только пока сдвиг распространяется);
+   - CPM: ES — прямой проход от нуля, LS — обратный от deadline()
+     (исходный makespan). Перетащенная мышью задача закрепляется на
+     своём начале до clear_changed(): ES = max(начало, ES по
+     предшественникам), LS = min(начало, LS по последователям).
+     После правки прямой проход идёт по конусу последователей
+     закреплённых/откреплённых задач, обратный — по конусу
+     предшественников, и каждый останавливается, где значения
+     перестали меняться. LS < ES — расписание не укладывается в срок;
+   - профиль загрузки ресурсов по моментам времени обновляется
+     только на старом и новом интервале задачи; конфликт — задача
+     выполняется в момент перегрузки ресурса, который она использует.
+   Ёмкость ресурса в момент t учитывает ModelOptions (календари).
+   =================================================================== */
+class ScheduleEditor {
+public:
+    ScheduleEditor(const RCPSPInstance& inst,
+                   const ModelOptions& options,
+                   const std::vector<std::pair<int, double>>& starts);
+
+    // Сдвигает и закрепляет задачу (не раньше конца предшественников),
+    // последователи сдвигаются следом.
+    // Возвращает id задач, у которых могло измениться состояние
+    std::vector<int> move_task(int id, int new_start);
+
+    // Применяет готовое расписание (например, после переоптимизации)
+    std::vector<int> assign(const std::vector<std::pair<int, double>>& starts);
+
+    int  start(int id) const          { return task_start[id - 1]; }
+    int  duration(int id) const       { return dur[id - 1]; }
+    int  earliest_start(int id) const { return es[id - 1]; }
+    int  latest_start(int id) const   { return ls[id - 1]; }
+    bool is_pinned(int id) const      { return pin[id - 1] >= 0; }
+    bool has_conflict(int id) const   { return conflict[id - 1] != 0; }
+    bool is_late(int id) const        { return task_start[id - 1] + dur[id - 1] > deadline_time; }
+    bool overloaded_at(int t) const;
+    int  deadline() const             { return deadline_time; }
+    int  horizon() const              { return (int)n_over.size(); }
+
+    // Моменты [from, to], где последнее обновление меняло профиль ресурсов
+    bool last_dirty_range(int& from, int& to) const;
+
+    // Задачи, сдвинутые с последнего clear_changed(), и все задачи,
+    // пересекающиеся с ними по времени — область для переоптимизации
+    std::vector<int> changed_region() const;
+    // Снимает закрепление; возвращает id задач с изменившимися ES/LS
+    std::vector<int> clear_changed();
+
+    std::vector<std::pair<int, double>> schedule() const;
+    const RCPSPInstance& instance() const { return inst; }
+    const ModelOptions&  model_options() const { return options; }
+
+private:
+    void ensure_horizon(int t);
+    int  capacity_at(int r, int t) const;
+    int  ready_time(int i) const;
+    void place(int i, int new_start);
+    void change_usage(int i, int from, int to, int sign);
+    bool check_conflict(int i) const;
+    void set_pin(int i, int value);
+    int  forward_es(int i) const;
+    int  backward_ls(int i) const;
+    void propagate_cpm(std::vector<int>& changed);
+    void begin_update();
+    std::vector<int> end_update();
+
+    RCPSPInstance inst;
+    ModelOptions  options;
+    int n;
+    int deadline_time;
+
+    std::vector<int> dur;
+    std::vector<std::vector<int>> req;            // req[i][r] — потребление ресурса r
+    std::vector<std::vector<int>> preds, succs;   // индексы 0..n-1
+    std::vector<int> topo;                        // позиция задачи в топологическом порядке
+
+    std::vector<int>  task_start, es, ls;
+    std::vector<int>  pin;                        // закреплённое начало, -1 — нет
+    std::vector<char> conflict;
+
+    // профиль ресурсов: usage[r][t], cap[r][t], over[r][t]
+    std::vector<std::vector<int>>  usage, cap;
+    std::vector<std::vector<char>> over;
+    std::vector<int> n_over;                      // число перегруженных ресурсов в момент t
+    std::vector<std::vector<int>> active;         // задачи, выполняющиеся в момент t
+
+    // состояние текущего обновления
+    std::vector<int>  shifted, dirty_times;       // сдвинутые задачи, изменённые моменты
+    std::vector<int>  pin_changed;                // источники пересчёта CPM
+    std::vector<char> redraw_mark, time_mark;
+    int dirty_from = 0, dirty_to = -1;
+
+    std::vector<char> moved_mark;
+    std::vector<int>  moved;
+};